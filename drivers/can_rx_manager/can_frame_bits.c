@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025 RobotPilots-SZU
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Bus length of CAN frames, shared by the bus statistics of the RX manager and the schedule
+ * of the TX manager so both report the same load for the same frames. Also built into the TX
+ * manager when the RX manager is disabled.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/sys/util.h>
+
+#include <drivers/can_rx_manager.h>
+
+#if defined(CONFIG_CAN_RX_MANAGER_BUS_STATS_EXACT_STUFFING)
+/* Bit stream of a classic frame: CRC-15 and dynamic stuff bit counter */
+struct rp_can_stuff {
+	uint16_t crc;
+	uint8_t prev;			/* previous bit, 2 before SOF */
+	uint8_t run;			/* identical bits in a row, stuff bits included */
+	uint32_t count;
+};
+
+/**
+ * @brief Append bits (MSB first) to a classic frame bit stream
+ *
+ * @param st    Stream state
+ * @param value Field value
+ * @param nbits Field width
+ * @param crc   Feed the bits into the CRC-15 (all fields before the CRC itself)
+ */
+static void rp_can_stuff_push(struct rp_can_stuff *st, uint32_t value, uint32_t nbits, bool crc)
+{
+	for (int i = (int)nbits - 1; i >= 0; i--) {
+		uint8_t bit = (uint8_t)((value >> i) & 1U);
+
+		if (crc) {
+			uint8_t nxt = bit ^ (uint8_t)((st->crc >> 14) & 1U);
+			st->crc = (uint16_t)((st->crc << 1) & 0x7FFFU);
+			if (nxt != 0U) {
+				st->crc ^= 0x4599U;
+			}
+		}
+		if (bit != st->prev) {
+			st->prev = bit;
+			st->run = 1U;
+		} else if (++st->run == 5U) {
+			/* the complementary stuff bit starts the next run */
+			st->count++;
+			st->prev = bit ^ 1U;
+			st->run = 1U;
+		}
+	}
+}
+
+/**
+ * @brief Count the stuff bits a classic CAN frame actually carries
+ *
+ * @param frame Classic CAN frame
+ * @param len   Payload length in bytes
+ * @return uint32_t Stuff bits between SOF and the end of the CRC
+ */
+static uint32_t rp_can_classic_stuff_bits(const struct can_frame *frame, uint32_t len)
+{
+	struct rp_can_stuff st = {.prev = 2U};
+	uint32_t rtr = ((frame->flags & CAN_FRAME_RTR) != 0U) ? 1U : 0U;
+
+	rp_can_stuff_push(&st, 0U, 1U, true);	/* SOF */
+	if ((frame->flags & CAN_FRAME_IDE) != 0U) {
+		rp_can_stuff_push(&st, frame->id >> 18, 11U, true);
+		rp_can_stuff_push(&st, 3U, 2U, true);	/* SRR, IDE */
+		rp_can_stuff_push(&st, frame->id & 0x3FFFFU, 18U, true);
+		rp_can_stuff_push(&st, rtr << 2, 3U, true);	/* RTR, r1, r0 */
+	} else {
+		rp_can_stuff_push(&st, frame->id & CAN_STD_ID_MASK, 11U, true);
+		rp_can_stuff_push(&st, rtr << 2, 3U, true);	/* RTR, IDE, r0 */
+	}
+	rp_can_stuff_push(&st, frame->dlc, 4U, true);
+	for (uint32_t i = 0; i < len; i++) {
+		rp_can_stuff_push(&st, frame->data[i], 8U, true);
+	}
+	rp_can_stuff_push(&st, st.crc, 15U, false);
+	return st.count;
+}
+#endif
+
+/**
+ * @brief Bits a frame occupies on the bus, stuff bits and interframe space included
+ *
+ * Classic frames use the worst-case stuffing bound floor((g + 8n - 1) / 4), or the actual
+ * stuff bits with CONFIG_CAN_RX_MANAGER_BUS_STATS_EXACT_STUFFING. CAN-FD frames always use
+ * the worst case for the dynamically stuffed part plus the fixed stuff bits of the CRC field.
+ *
+ * @param frame        CAN frame
+ * @param nominal      Output: bits at the nominal bitrate
+ * @param data_phase   Output: bits at the data bitrate (FD with BRS only)
+ */
+void can_rx_manager_frame_bits(const struct can_frame *frame, uint32_t *nominal, uint32_t *data_phase)
+{
+	bool ext = (frame->flags & CAN_FRAME_IDE) != 0U;
+	uint32_t len = ((frame->flags & CAN_FRAME_RTR) != 0U) ? 0U : can_dlc_to_bytes(frame->dlc);
+
+	if ((frame->flags & CAN_FRAME_FDF) == 0U) {
+		/* g: SOF..CRC without payload; CRC delimiter, ACK, EOF and IFS add 13 unstuffed bits */
+		uint32_t g = ext ? 54U : 34U;
+		len = MIN(len, 8U);
+#if defined(CONFIG_CAN_RX_MANAGER_BUS_STATS_EXACT_STUFFING)
+		uint32_t stuff = rp_can_classic_stuff_bits(frame, len);
+#else
+		uint32_t stuff = (g + 8U * len - 1U) / 4U;
+#endif
+		*nominal = g + 8U * len + 13U + stuff;
+		*data_phase = 0U;
+		return;
+	}
+
+	/* arbitration: SOF, ID, RRS/SRR, IDE, FDF, res, BRS */
+	uint32_t arb = ext ? 36U : 17U;
+	/* data phase: ESI, DLC, payload (dynamic stuffing), stuff count + CRC with fixed stuff bits */
+	uint32_t dyn = 5U + 8U * len;
+	uint32_t crc = (len <= 16U) ? (4U + 17U + 6U) : (4U + 21U + 7U);
+	uint32_t arb_bits = arb + (arb - 1U) / 4U;
+	uint32_t data_bits = dyn + dyn / 4U + crc;
+
+	if ((frame->flags & CAN_FRAME_BRS) != 0U) {
+		*nominal = arb_bits + 13U;
+		*data_phase = data_bits;
+	} else {
+		*nominal = arb_bits + data_bits + 13U;
+		*data_phase = 0U;
+	}
+}
@@ -12,6 +12,7 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
 
 #include <string.h>
 
@@ -20,470 +21,3028 @@
 #define LOG_LEVEL 3
 LOG_MODULE_REGISTER(can_rx_manager);
 
+/* Listener slot index type; the all-ones value marks the end of a chain / an empty table entry */
+#if CONFIG_CAN_RX_MANAGER_MAX_LISTENERS < 255
+typedef uint8_t rp_can_rx_slot_t;
+#else
+typedef uint16_t rp_can_rx_slot_t;
+#endif
+#define RP_CAN_RX_SLOT_NONE ((rp_can_rx_slot_t)-1)
+
+/* Hardware filter elements a manager may own: the MCAN budget plus one accept-all per ID type */
+#define RP_CAN_RX_HW_FILTERS_MAX (CONFIG_CAN_MCAN_SD_FILTERS_NBR + CONFIG_CAN_MCAN_EX_FILTERS_NBR + 2)
 
 struct rp_can_rx_listener {
 	bool used;
 	struct can_filter filter;
 	can_rx_handler_t handler;
 	void *user_data;
+	uint32_t flags;			/* CAN_RX_LISTENER_* registration flags */
+	rp_can_rx_slot_t next;		/* next listener on the same exact standard ID */
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	int16_t mbox;			/* mailbox index for CAN_RX_LISTENER_MAILBOX, else -1 */
+#endif
+};
+
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+/* Latest-value slot of a CAN_RX_LISTENER_MAILBOX listener; the ISR overwrites, the thread consumes */
+struct rp_can_rx_mailbox {
+	int16_t owner;			/* listener slot, -1 when free */
+	bool dirty;			/* holds a frame the listener has not seen yet */
+	uint32_t coalesced;		/* frames overwritten before the thread consumed them */
+	struct can_rx_meta meta;
+	struct can_frame frame;
+};
+#endif
+
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+/* Arrival tracker of a watched listener; times are k_cycle_get_32() cycles */
+struct rp_can_rx_live {
+	int16_t owner;			/* listener slot, -1 when free */
+	uint8_t state;			/* enum can_rx_liveness */
+	uint8_t learned;		/* intervals averaged so far, up to CAN_RX_MANAGER_LIVENESS_LEARN */
+	uint32_t last;			/* arrival of the newest frame, or the watch start */
+	uint32_t period;		/* mean interval */
+	uint32_t jitter;		/* mean absolute deviation of the interval from period */
+	uint32_t min;
+	uint32_t max;
+	uint32_t timeout;		/* offline timeout, 0 to derive it from period */
+	uint32_t frames;
+	uint32_t late;
+	uint32_t offline;
+	can_rx_liveness_cb_t cb;
+	void *user_data;
+};
+#endif
+
+#if defined(CONFIG_CAN_RX_MANAGER_BUS_RECOVERY)
+/* Controller state history of a manager's bus; the state change ISR and the recovery work feed it */
+struct rp_can_rx_health {
+	const struct device *mgr;
+	struct k_spinlock lock;
+	atomic_t state;			/* enum can_state last reported, never CAN_STATE_STOPPED */
+	int64_t since;			/* k_uptime_ticks() when state was entered */
+	uint32_t off_cycles;		/* k_cycle_get_32() when the bus went off */
+	struct can_bus_err_cnt err_cnt;
+	uint32_t error_passive;
+	uint32_t bus_off;
+	uint32_t restarts;
+	uint32_t recoveries;
+	int64_t passive_ticks;		/* closed error-passive periods */
+	int64_t off_ticks;		/* closed bus-off periods */
+	uint32_t last_us;
+	uint32_t max_us;
+	uint32_t backoff_min;		/* ms, at least the bus-off recovery time of the bitrate */
+	uint32_t backoff_ms;		/* delay of the next restart */
+	uint32_t grace_ms;		/* ms, automatic recovery mode: at least the worst-case recovery time */
+	bool settled;			/* error-active for the hold-off period since the last bus-off */
+	can_state_change_callback_t cb;	/* application callback the changes are forwarded to */
+	void *user_data;
+	struct k_work_delayable work;
+};
+#endif
+
+/*
+ * One RX ring record: the frame header, the metadata captured with it in the ISR and only
+ * the payload bytes actually received, padded to 4 bytes. A classic frame takes the same
+ * room as before, a 64-byte FD frame no longer makes every slot 64 bytes wide.
+ */
+struct rp_can_rx_rec {
+	struct can_rx_meta meta;
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+	uint32_t enq_cycles;		/* k_cycle_get_32() when the record was published */
+#endif
+	uint32_t id;
+	uint8_t dlc;			/* RP_CAN_RX_REC_WRAP: continue at the start of the ring */
+	uint8_t flags;
+	uint16_t timestamp;
+	uint8_t data[];
 };
 
+#define RP_CAN_RX_REC_WRAP 0xFFU
+#define RP_CAN_RX_REC_SIZE(len) ROUND_UP(sizeof(struct rp_can_rx_rec) + (len), sizeof(uint32_t))
+/* Ring lengths are configured in classic frames: one such record per configured slot */
+#define RP_CAN_RX_RING_WORDS(frames)                                                            \
+	(MAX((frames) * RP_CAN_RX_REC_SIZE(CAN_MAX_DLC), 2U * RP_CAN_RX_REC_SIZE(CAN_MAX_DLEN)) /    \
+	 sizeof(uint32_t))
+
+/* Listener priority classes: class 0 uses the configured ring length, the others share one */
+#define RP_CAN_RX_CLASSES CONFIG_CAN_RX_MANAGER_RX_CLASSES
+#if RP_CAN_RX_CLASSES > 1
+#define RP_CAN_RX_CLASS_RING_WORDS RP_CAN_RX_RING_WORDS(CONFIG_CAN_RX_MANAGER_RX_CLASS_MSGQ_LEN)
+#define RP_CAN_RX_CLASS_PRIO_STEP  CONFIG_CAN_RX_MANAGER_RX_CLASS_PRIO_STEP
+#else
+#define RP_CAN_RX_CLASS_RING_WORDS 0
+#define RP_CAN_RX_CLASS_PRIO_STEP  0
+#endif
+#define RP_CAN_RX_CLASS_RING_SIZE (RP_CAN_RX_CLASS_RING_WORDS * sizeof(uint32_t))
+
+/* Dispatch context: the CAN RX ISR, or the worker of listener class n >= 0 */
+#define RP_CAN_RX_CTX_ISR (-1)
+
 struct rp_can_rx_manager_cfg {
 	const struct device *can_dev;
-	struct k_msgq *rx_msgq;
-	k_thread_stack_t *rx_stack;
+	uint32_t *ring_buf;		/* SPSC record rings, class 0 first: ISR produces, class workers consume */
+	uint32_t ring_size;		/* class 0 ring in bytes; the others take RP_CAN_RX_CLASS_RING_SIZE */
+	struct k_sem *rx_sem;		/* per class: wakes the RX thread serving this manager */
+	atomic_t *rx_idle;		/* per class: 1 while that thread is about to sleep on rx_sem */
+	const struct device *const *rx_devs;	/* managers drained by those threads */
+	size_t rx_dev_num;
+	k_thread_stack_t *rx_stack;	/* class 0 stack, the next class starts rx_stack_len further */
+	size_t rx_stack_len;
 	size_t rx_stack_size;
+	int rx_thread_prio;		/* class 0; class n runs n x RP_CAN_RX_CLASS_PRIO_STEP levels lower */
+	bool dedicated_rx_thread;	/* own ring/thread instead of the shared thread */
+	uint32_t bitrate;		/* nominal bitrate of the bus, from devicetree */
+	uint32_t bitrate_data;		/* CAN-FD data bitrate, 0 if the bus is classic */
+};
+
+/* Bus statistics directions, index of the per-direction counters */
+#define RP_CAN_BUS_RX 0
+#define RP_CAN_BUS_TX 1
+
+/* One slice of the sliding bus statistics window */
+struct rp_can_bus_slice {
+	uint32_t epoch;			/* uptime / slice length the counters belong to */
+	uint32_t frames[2];
+	uint32_t bits_nominal[2];
+	uint32_t bits_data[2];
+};
+
+#if CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS > 0
+#define RP_CAN_BUS_KEY_USED BIT(31)
+#define RP_CAN_BUS_KEY_EXT  BIT(30)
+#define RP_CAN_BUS_KEY_TX   BIT(29)
+
+/* Per-ID frame counters, one per window slice; open addressing on the key */
+struct rp_can_bus_id {
+	uint32_t key;			/* RP_CAN_BUS_KEY_* | id, 0 when free */
+	uint16_t frames[CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES];
+};
+#endif
+
+
+/*
+ * Everything the dispatch path reads about listeners. A manager keeps two copies: readers
+ * only ever see the published one, writers edit the other and publish it as a whole.
+ */
+struct rp_can_rx_table {
+	struct rp_can_rx_listener listeners[CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];
+#if defined(CONFIG_CAN_RX_MANAGER_ID_TABLE)
+	/* exact 11-bit standard ID -> head of its listener chain */
+	rp_can_rx_slot_t std_table[CAN_STD_ID_MASK + 1];
+#endif
+	/* masked/extended listeners, matched in software in registration order */
+	rp_can_rx_slot_t fallback[CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];
+	uint16_t fallback_num;
+	uint16_t isr_num;		/* listeners handled at interrupt time (ISR or mailbox) */
+	uint16_t routed_num;		/* thread listeners outside class 0, routed by the ISR */
+};
+
+struct rp_can_rx_manager_data {
+	struct rp_can_rx_table tables[2];
+	atomic_t active;		/* index of the published table */
+	atomic_t readers[2];		/* dispatch sections currently inside each table */
+	atomic_t rx_held[RP_CAN_RX_CLASSES];	/* table each class worker dispatches from, -1 outside */
+	k_tid_t rx_tid[RP_CAN_RX_CLASSES];	/* class workers draining this manager */
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	struct rp_can_rx_mailbox mbox[CONFIG_CAN_RX_MANAGER_MAILBOX_NUM];
+	struct k_spinlock mbox_lock;
+	atomic_t mbox_doorbell;		/* 1 while dirty mailboxes wait for the RX thread */
+	uint16_t mbox_dirty;		/* mailboxes holding an unconsumed frame */
+	atomic_t mbox_coalesced;	/* total frames overwritten in mailboxes */
+#endif
+	atomic_t ring_head[RP_CAN_RX_CLASSES];	/* byte offset the ISR writes next; only the ISR stores it */
+	atomic_t ring_tail[RP_CAN_RX_CLASSES];	/* byte offset the worker reads next; only it stores it */
+	struct k_thread rx_thread[RP_CAN_RX_CLASSES];
+	struct k_mutex reg_lock;	/* serializes (un)registration and hardware filter reprogramming */
+	int hw_filter_ids[RP_CAN_RX_HW_FILTERS_MAX];
+	uint8_t hw_filter_num;
+#if defined(CONFIG_CAN_RX_MANAGER_HW_FILTER)
+	struct can_filter hw_scratch[CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
+	atomic_t rx_dropped;
+	atomic_t rx_queued;
+	atomic_t ring_hwm[RP_CAN_RX_CLASSES];	/* peak ring occupancy in bytes since the last read */
+	uint32_t last_reported_drops;
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+	struct k_spinlock stats_lock;	/* histograms are updated from the ISR and the RX thread */
+	struct can_rx_manager_stats stats;
+#if defined(CONFIG_CAN_RX_MANAGER_STATS_PER_LISTENER)
+	struct can_rx_latency_hist lst_stats[CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];
+#endif
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_CAPTURE)
+	uint8_t cap_buf[CONFIG_CAN_RX_MANAGER_CAPTURE_SIZE];
+	atomic_t cap_head;		/* free-running byte counter, only the ISR stores it */
+	atomic_t cap_tail;		/* free-running byte counter, only the reader stores it */
+	atomic_t cap_on;
+	bool cap_hdr;			/* pcap file header not read yet */
+	uint32_t cap_frames;
+	uint32_t cap_dropped;
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+	struct rp_can_rx_live live[CONFIG_CAN_RX_MANAGER_LIVENESS_NUM];
+	int16_t live_idx[CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];	/* listener slot -> tracker, -1 if unwatched */
+	struct k_spinlock live_lock;	/* trackers are fed from the ISR/RX thread and checked by live_timer */
+	struct k_timer live_timer;	/* armed to the earliest deadline of all trackers */
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_BUS_RECOVERY)
+	struct rp_can_rx_health health;
+#endif
+	struct k_spinlock bus_lock;	/* bus statistics are fed from the ISR and TX threads */
+	struct can_bus_traffic bus_total[2];
+	struct rp_can_bus_slice bus_slice[CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES];
+	uint32_t bus_epoch;		/* newest slice in bus_slice */
+#if CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS > 0
+	struct rp_can_bus_id bus_ids[CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS];
+#endif
+	uint32_t bus_id_overflow;
+};
+
+/* Number of instances without `dedicated-rx-thread`; the shared thread only exists if > 0 */
+#define RP_CAN_RX_MGR_SHARED_USER(inst) +(1 - DT_INST_PROP(inst, dedicated_rx_thread))
+#define RP_CAN_RX_MGR_SHARED_USERS (0 DT_INST_FOREACH_STATUS_OKAY(RP_CAN_RX_MGR_SHARED_USER))
+
+#if RP_CAN_RX_MGR_SHARED_USERS > 0
+#define RP_CAN_RX_MGR_SHARED_PTR(inst) \
+	IF_DISABLED(DT_INST_PROP(inst, dedicated_rx_thread), (DEVICE_DT_INST_GET(inst),))
+
+/* Shared mode keeps the RAM of the former single queue: its length is split among the buses.
+ * An enum, because DT_INST_FOREACH_STATUS_OKAY cannot be expanded again inside RP_CAN_RX_MGR_DEFINE. */
+enum {
+	RP_CAN_RX_SHARED_RING_LEN = MAX(CONFIG_CAN_RX_MANAGER_RX_MSGQ_LEN / RP_CAN_RX_MGR_SHARED_USERS, 4),
+};
+
+static const struct device *const rp_can_rx_shared_devs[] = {
+	DT_INST_FOREACH_STATUS_OKAY(RP_CAN_RX_MGR_SHARED_PTR)
 };
+static struct k_sem rp_can_rx_shared_sem[RP_CAN_RX_CLASSES];
+static atomic_t rp_can_rx_shared_idle[RP_CAN_RX_CLASSES];
+K_THREAD_STACK_ARRAY_DEFINE(rp_can_rx_shared_stack, RP_CAN_RX_CLASSES, CONFIG_CAN_RX_MANAGER_RX_STACK_SIZE);
+static struct k_thread rp_can_rx_shared_thread_data[RP_CAN_RX_CLASSES];
+static atomic_t rp_can_rx_shared_started = ATOMIC_INIT(0);
+#endif
+
+/**
+ * @brief Give up the claim on starting the shared workers after a failed init
+ *
+ * The next shared instance to initialize takes the claim over, so the shared rings are still
+ * drained when the first instance fails.
+ *
+ * @param shared_first True if this instance took the claim
+ */
+static void rp_can_rx_shared_unclaim(bool shared_first)
+{
+#if RP_CAN_RX_MGR_SHARED_USERS > 0
+	if (shared_first) {
+		atomic_set(&rp_can_rx_shared_started, 0);
+	}
+#else
+	ARG_UNUSED(shared_first);
+#endif
+}
+
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+/**
+ * @brief Add one latency sample to a histogram
+ *
+ * @param data Manager runtime data (owns the lock)
+ * @param hist Histogram of that manager
+ * @param cyc  Latency in hardware cycles
+ */
+static void rp_can_rx_stats_add(struct rp_can_rx_manager_data *data, struct can_rx_latency_hist *hist,
+				uint32_t cyc)
+{
+	uint32_t b = (cyc == 0U) ? 0U : (31U - (uint32_t)__builtin_clz(cyc));
+
+	k_spinlock_key_t key = k_spin_lock(&data->stats_lock);
+	if ((hist->count == 0U) || (cyc < hist->min)) {
+		hist->min = cyc;
+	}
+	hist->max = MAX(hist->max, cyc);
+	hist->sum += cyc;
+	hist->count++;
+	hist->bucket[MIN(b, CAN_RX_STATS_BUCKETS - 1U)]++;
+	k_spin_unlock(&data->stats_lock, key);
+}
+#endif
+
+/**
+ * @brief Wake the RX thread serving a class of a manager if it announced it is going to sleep
+ *
+ * @param cfg Manager configuration
+ * @param cls Listener class
+ */
+static inline void rp_can_rx_wake(const struct rp_can_rx_manager_cfg *cfg, int cls)
+{
+	if (atomic_cas(&cfg->rx_idle[cls], 1, 0)) {
+		k_sem_give(&cfg->rx_sem[cls]);
+	}
+}
+
+/**
+ * @brief Enter the published listener table (ISR or RX thread, never blocks)
+ *
+ * The reader count is raised before the index is re-checked, so a writer either sees the
+ * reader or the reader sees the newer table and moves over to it.
+ *
+ * @param data Manager runtime data
+ * @return int Index of the table to dispatch from, pass it to rp_can_rx_read_unlock()
+ */
+static inline int rp_can_rx_read_lock(struct rp_can_rx_manager_data *data)
+{
+	while (true) {
+		int gen = (int)atomic_get(&data->active);
+
+		(void)atomic_inc(&data->readers[gen]);
+		if (atomic_get(&data->active) == gen) {
+			return gen;
+		}
+		(void)atomic_dec(&data->readers[gen]);
+	}
+}
+
+static inline void rp_can_rx_read_unlock(struct rp_can_rx_manager_data *data, int gen)
+{
+	(void)atomic_dec(&data->readers[gen]);
+}
+
+/**
+ * @brief Payload bytes carried by a frame
+ */
+static inline uint8_t rp_can_rx_frame_len(const struct can_frame *frame)
+{
+	if ((frame->flags & CAN_FRAME_RTR) != 0U) {
+		return 0U;
+	}
+	if ((frame->flags & CAN_FRAME_FDF) == 0U) {
+		return MIN(frame->dlc, CAN_MAX_DLC);	/* classic DLC 9..15 still means 8 bytes */
+	}
+	return MIN(can_dlc_to_bytes(frame->dlc), (uint8_t)CAN_MAX_DLEN);
+}
+
+/**
+ * @brief Size in bytes of the RX ring of a listener class
+ */
+static inline uint32_t rp_can_rx_ring_len(const struct rp_can_rx_manager_cfg *cfg, int cls)
+{
+	return (cls == 0) ? cfg->ring_size : RP_CAN_RX_CLASS_RING_SIZE;
+}
+
+static inline struct rp_can_rx_rec *rp_can_rx_rec_at(const struct rp_can_rx_manager_cfg *cfg, int cls,
+						      uint32_t off)
+{
+	/* the class rings follow the class 0 ring in the same buffer */
+	uint32_t base = (cls == 0) ? 0U : (cfg->ring_size + (uint32_t)(cls - 1) * RP_CAN_RX_CLASS_RING_SIZE);
+
+	return (struct rp_can_rx_rec *)((uint8_t *)cfg->ring_buf + base + off);
+}
+
+/**
+ * @brief Find room for a record of @p size bytes in an RX ring of the manager
+ *
+ * @param cfg  Manager configuration
+ * @param data Manager runtime data
+ * @param cls  Listener class owning the ring
+ * @param size Record size, see RP_CAN_RX_REC_SIZE()
+ * @param pos  Offset the record would be written at
+ * @param next Head offset after the record
+ * @return true if the record fits
+ */
+static bool rp_can_rx_ring_room(const struct rp_can_rx_manager_cfg *cfg, struct rp_can_rx_manager_data *data,
+				int cls, uint32_t size, uint32_t *pos, uint32_t *next)
+{
+	uint32_t head = (uint32_t)atomic_get(&data->ring_head[cls]);
+	uint32_t tail = (uint32_t)atomic_get(&data->ring_tail[cls]);
+	uint32_t ring_size = rp_can_rx_ring_len(cfg, cls);
+
+	*pos = head;
+	if ((head >= tail) && (ring_size - head < size)) {
+		if (tail == 0U) {
+			return false;		/* the reader still owns offset 0 */
+		}
+		*pos = 0U;			/* does not fit before the end: wrap */
+	}
+	*next = *pos + size;
+	if (*pos < tail) {
+		if (*next >= tail) {
+			return false;		/* keep a gap: head == tail means empty */
+		}
+	} else if (*next == ring_size) {
+		if (tail == 0U) {
+			return false;
+		}
+		*next = 0U;
+	}
+	return true;
+}
+
+/**
+ * @brief Append a frame to an SPSC record ring of the manager (ISR context, single producer)
+ *
+ * A record never wraps around the end of the buffer: if it does not fit there, a wrap
+ * marker (or, when not even a header fits, nothing) sends the consumer back to offset 0.
+ *
+ * @param cfg   Manager configuration
+ * @param data  Manager runtime data
+ * @param cls   Listener class whose worker gets the frame
+ * @param frame Received CAN frame
+ * @param meta  Reception metadata
+ * @return int  0 on success, -ENOMSG if the ring is full
+ */
+static int rp_can_rx_ring_put(const struct rp_can_rx_manager_cfg *cfg, struct rp_can_rx_manager_data *data,
+			      int cls, const struct can_frame *frame, const struct can_rx_meta *meta)
+{
+	uint8_t len = rp_can_rx_frame_len(frame);
+	uint32_t head = (uint32_t)atomic_get(&data->ring_head[cls]);
+	uint32_t ring_size = rp_can_rx_ring_len(cfg, cls);
+	uint32_t pos;
+	uint32_t next;
+
+	if (!rp_can_rx_ring_room(cfg, data, cls, RP_CAN_RX_REC_SIZE(len), &pos, &next)) {
+		return -ENOMSG;
+	}
+	if ((pos != head) && (ring_size - head >= sizeof(struct rp_can_rx_rec))) {
+		rp_can_rx_rec_at(cfg, cls, head)->dlc = RP_CAN_RX_REC_WRAP;
+	}
+
+	struct rp_can_rx_rec *rec = rp_can_rx_rec_at(cfg, cls, pos);
+	rec->meta = *meta;
+	rec->id = frame->id;
+	rec->dlc = frame->dlc;
+	rec->flags = frame->flags;
+#if defined(CONFIG_CAN_RX_TIMESTAMP)
+	rec->timestamp = frame->timestamp;
+#endif
+	memcpy(rec->data, frame->data, len);
+#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
+	uint32_t used = (next + ring_size - (uint32_t)atomic_get(&data->ring_tail[cls])) % ring_size;
+	if (used > (uint32_t)atomic_get(&data->ring_hwm[cls])) {
+		atomic_set(&data->ring_hwm[cls], (atomic_val_t)used);
+	}
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+	uint32_t now = k_cycle_get_32();
+	rec->enq_cycles = now;
+	rp_can_rx_stats_add(data, &data->stats.isr, now - meta->rx_cycles);
+#endif
+	atomic_set(&data->ring_head[cls], (atomic_val_t)next);	/* publish after the record is written */
+	rp_can_rx_wake(cfg, cls);
+	return 0;
+}
+
+/**
+ * @brief Start the slice of a new epoch, clearing all slices skipped since the last frame
+ *
+ * @param data  Manager runtime data, bus_lock held
+ * @param epoch Current slice number
+ */
+static void rp_can_bus_rotate(struct rp_can_rx_manager_data *data, uint32_t epoch)
+{
+	uint32_t n = MIN(epoch - data->bus_epoch, (uint32_t)CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES);
+
+	for (uint32_t k = n; k > 0U; k--) {
+		uint32_t e = epoch - k + 1U;
+		uint32_t idx = e % CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES;
+
+		memset(&data->bus_slice[idx], 0, sizeof(data->bus_slice[idx]));
+		data->bus_slice[idx].epoch = e;
+#if CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS > 0
+		for (int i = 0; i < CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS; i++) {
+			data->bus_ids[i].frames[idx] = 0U;
+		}
+#endif
+	}
+	data->bus_epoch = epoch;
+}
+
+#if CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS > 0
+/**
+ * @brief Count a frame in the per-ID table
+ *
+ * @param data  Manager runtime data, bus_lock held
+ * @param frame CAN frame
+ * @param dir   RP_CAN_BUS_RX or RP_CAN_BUS_TX
+ * @param idx   Slice index of the current epoch
+ */
+static void rp_can_bus_count_id(struct rp_can_rx_manager_data *data, const struct can_frame *frame,
+				int dir, uint32_t idx)
+{
+	uint32_t key = RP_CAN_BUS_KEY_USED | (frame->id & CAN_EXT_ID_MASK);
+
+	if ((frame->flags & CAN_FRAME_IDE) != 0U) {
+		key |= RP_CAN_BUS_KEY_EXT;
+	}
+	if (dir == RP_CAN_BUS_TX) {
+		key |= RP_CAN_BUS_KEY_TX;
+	}
+	for (uint32_t probe = 0; probe < CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS; probe++) {
+		struct rp_can_bus_id *ent =
+			&data->bus_ids[(key + probe) % CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS];
+
+		if (ent->key == 0U) {
+			ent->key = key;
+		} else if (ent->key != key) {
+			continue;
+		}
+		if (ent->frames[idx] < UINT16_MAX) {
+			ent->frames[idx]++;
+		}
+		return;
+	}
+	data->bus_id_overflow++;
+}
+#endif
+
+/**
+ * @brief Add a frame to the bus statistics (any context)
+ *
+ * @param data  Manager runtime data
+ * @param frame Received or transmitted frame
+ * @param dir   RP_CAN_BUS_RX or RP_CAN_BUS_TX
+ */
+static void rp_can_bus_account(struct rp_can_rx_manager_data *data, const struct can_frame *frame, int dir)
+{
+	uint32_t nominal;
+	uint32_t data_phase;
+
+	can_rx_manager_frame_bits(frame, &nominal, &data_phase);
+	uint32_t epoch = (uint32_t)(k_uptime_get() / CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICE_MS);
+
+	k_spinlock_key_t key = k_spin_lock(&data->bus_lock);
+	if (epoch != data->bus_epoch) {
+		rp_can_bus_rotate(data, epoch);
+	}
+	uint32_t idx = epoch % CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES;
+	struct rp_can_bus_slice *sl = &data->bus_slice[idx];
+
+	data->bus_total[dir].frames++;
+	data->bus_total[dir].bits_nominal += nominal;
+	data->bus_total[dir].bits_data += data_phase;
+	sl->frames[dir]++;
+	sl->bits_nominal[dir] += nominal;
+	sl->bits_data[dir] += data_phase;
+#if CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS > 0
+	rp_can_bus_count_id(data, frame, dir, idx);
+#endif
+	k_spin_unlock(&data->bus_lock, key);
+}
+
+static uint32_t rp_can_rx_dispatch(struct rp_can_rx_manager_data *data, const struct rp_can_rx_table *tbl,
+				   const struct can_frame *frame, const struct can_rx_meta *meta, int ctx);
+
+#if defined(CONFIG_CAN_RX_MANAGER_CAPTURE)
+/* pcap (LINKTYPE_CAN_SOCKETCAN) layout of the capture stream */
+#define RP_CAN_CAP_MAGIC     0xA1B2C3D4U
+#define RP_CAN_CAP_MAGIC_NS  0xA1B23C4DU
+#define RP_CAN_CAP_LINKTYPE  227U
+#define RP_CAN_CAP_REC_HDR   16U	/* ts_sec, ts_usec, incl_len, orig_len */
+#define RP_CAN_CAP_CAN_HDR   8U		/* can_id (big endian), len, fd flags, 2 reserved */
+#define RP_CAN_CAP_MTU       16U	/* orig_len of a classic frame */
+#define RP_CAN_CAP_FD_MTU    72U	/* orig_len of a CAN-FD frame */
+#define RP_CAN_CAP_EFF       BIT(31)
+#define RP_CAN_CAP_RTR       BIT(30)
+#define RP_CAN_CAP_ERR       BIT(29)
+#define RP_CAN_CAP_FD_BRS    BIT(0)
+#define RP_CAN_CAP_FD_ESI    BIT(1)
+#define RP_CAN_CAP_FD_FDF    BIT(2)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_CAN_RX_MANAGER_CAPTURE_SIZE),
+	     "CONFIG_CAN_RX_MANAGER_CAPTURE_SIZE must be a power of two");
+
+/**
+ * @brief Capture and replay time base in microseconds
+ */
+static inline int64_t rp_can_rx_capture_now_us(void)
+{
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+	return (int64_t)k_cyc_to_us_floor64(k_cycle_get_64());
+#else
+	return (int64_t)k_ticks_to_us_floor64((uint64_t)k_uptime_ticks());
+#endif
+}
+
+/**
+ * @brief Copy bytes into the capture ring at a free-running position
+ */
+static void rp_can_rx_capture_copy_in(struct rp_can_rx_manager_data *data, uint32_t pos, const void *src,
+				      uint32_t n)
+{
+	uint32_t off = pos & (CONFIG_CAN_RX_MANAGER_CAPTURE_SIZE - 1U);
+	uint32_t first = MIN(n, CONFIG_CAN_RX_MANAGER_CAPTURE_SIZE - off);
+
+	memcpy(&data->cap_buf[off], src, first);
+	memcpy(data->cap_buf, (const uint8_t *)src + first, n - first);
+}
+
+/**
+ * @brief Copy bytes out of the capture ring at a free-running position
+ */
+static void rp_can_rx_capture_copy_out(struct rp_can_rx_manager_data *data, uint32_t pos, void *dst, uint32_t n)
+{
+	uint32_t off = pos & (CONFIG_CAN_RX_MANAGER_CAPTURE_SIZE - 1U);
+	uint32_t first = MIN(n, CONFIG_CAN_RX_MANAGER_CAPTURE_SIZE - off);
+
+	memcpy(dst, &data->cap_buf[off], first);
+	memcpy((uint8_t *)dst + first, data->cap_buf, n - first);
+}
+
+/**
+ * @brief Record a received frame in the capture ring (ISR context, single producer)
+ *
+ * The record is stored in its final pcap form, so reading it out is a plain copy.
+ *
+ * @param data  Manager runtime data
+ * @param frame Received CAN frame, RTR included
+ */
+static void rp_can_rx_capture_put(struct rp_can_rx_manager_data *data, const struct can_frame *frame)
+{
+	if (atomic_get(&data->cap_on) == 0) {
+		return;
+	}
+
+	bool fd = (frame->flags & CAN_FRAME_FDF) != 0U;
+	bool rtr = (frame->flags & CAN_FRAME_RTR) != 0U;
+	uint8_t len = rp_can_rx_frame_len(frame);
+	uint32_t size = RP_CAN_CAP_REC_HDR + RP_CAN_CAP_CAN_HDR + len;
+	uint32_t head = (uint32_t)atomic_get(&data->cap_head);
+	uint32_t tail = (uint32_t)atomic_get(&data->cap_tail);
+
+	if (CONFIG_CAN_RX_MANAGER_CAPTURE_SIZE - (head - tail) < size) {
+		data->cap_dropped++;
+		return;
+	}
+
+	uint64_t us = (uint64_t)rp_can_rx_capture_now_us();
+	uint32_t hdr[4] = {
+		(uint32_t)(us / USEC_PER_SEC),
+		(uint32_t)(us % USEC_PER_SEC),
+		RP_CAN_CAP_CAN_HDR + len,
+		fd ? RP_CAN_CAP_FD_MTU : RP_CAN_CAP_MTU,
+	};
+	uint8_t can_hdr[RP_CAN_CAP_CAN_HDR] = {0};
+	uint32_t can_id = frame->id;
+
+	if ((frame->flags & CAN_FRAME_IDE) != 0U) {
+		can_id |= RP_CAN_CAP_EFF;
+	}
+	if (rtr) {
+		can_id |= RP_CAN_CAP_RTR;
+	}
+	sys_put_be32(can_id, can_hdr);
+	can_hdr[4] = rtr ? frame->dlc : len;	/* SocketCAN keeps the requested DLC of an RTR frame */
+	if (fd) {
+		can_hdr[5] = RP_CAN_CAP_FD_FDF | (((frame->flags & CAN_FRAME_BRS) != 0U) ? RP_CAN_CAP_FD_BRS : 0U) |
+			     (((frame->flags & CAN_FRAME_ESI) != 0U) ? RP_CAN_CAP_FD_ESI : 0U);
+	}
+
+	rp_can_rx_capture_copy_in(data, head, hdr, sizeof(hdr));
+	rp_can_rx_capture_copy_in(data, head + sizeof(hdr), can_hdr, sizeof(can_hdr));
+	rp_can_rx_capture_copy_in(data, head + sizeof(hdr) + sizeof(can_hdr), frame->data, len);
+	data->cap_frames++;
+	atomic_set(&data->cap_head, (atomic_val_t)(head + size));	/* publish after the record is written */
+}
+#endif /* CONFIG_CAN_RX_MANAGER_CAPTURE */
+
+/**
+ * @brief Run one received frame through bus statistics, ISR listeners and the RX ring
+ *
+ * Shared by the CAN ISR and trace replay; the caller runs it with interrupts locked.
+ *
+ * @param mgr   CAN RX manager device
+ * @param frame Received CAN frame
+ * @param meta  Reception metadata, sampled when the frame arrived
+ */
+static void rp_can_rx_ingest(const struct device *mgr, const struct can_frame *frame,
+			     const struct can_rx_meta *meta)
+{
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+
+	if (data == NULL) {
+		return;
+	}
+	/* every accepted frame occupies the bus, RTR included */
+	rp_can_bus_account(data, frame, RP_CAN_BUS_RX);
+
+	/* Skip RTR frames by default */
+	if ((frame->flags & CAN_FRAME_RTR) != 0U) {
+		return;
+	}
+	uint32_t pending = BIT(0);	/* classes whose worker needs the frame */
+
+	/*
+	 * Fast path: run ISR listeners right here and only queue the frame for the classes that
+	 * have a matching thread listener. Without ISR listeners or other classes, matching is
+	 * left to the class 0 worker.
+	 */
+	int gen = rp_can_rx_read_lock(data);
+	const struct rp_can_rx_table *tbl = &data->tables[gen];
+
+	if ((tbl->isr_num > 0U) || (tbl->routed_num > 0U)) {
+		pending = rp_can_rx_dispatch(data, tbl, frame, meta, RP_CAN_RX_CTX_ISR);
+	}
+	rp_can_rx_read_unlock(data, gen);
+
+	for (int cls = 0; (pending != 0U) && (cls < RP_CAN_RX_CLASSES); cls++) {
+		if ((pending & BIT(cls)) == 0U) {
+			continue;
+		}
+		pending &= ~BIT(cls);
+		int ret = rp_can_rx_ring_put(cfg, data, cls, frame, meta);
+#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
+		/* update per-manager counters for monitoring */
+		(void)atomic_inc((ret == 0) ? &data->rx_queued : &data->rx_dropped);
+#endif
+		ARG_UNUSED(ret);
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	/* Fresh mailbox content needs no ring slot, only a wakeup of the class 0 worker */
+	if ((data->mbox_dirty > 0U) && atomic_cas(&data->mbox_doorbell, 0, 1)) {
+		rp_can_rx_wake(cfg, 0);
+	}
+#endif
+}
+
+static void rp_can_rx_isr_cb(const struct device *can_dev, struct can_frame *frame, void *user_data)
+{
+	ARG_UNUSED(can_dev);
+
+	/* sample first so the arrival time excludes the dispatch below */
+	const struct can_rx_meta meta = {
+		.rx_cycles = k_cycle_get_32(),
+	};
+	const struct device *mgr = (const struct device *)user_data;
+	if ((mgr == NULL) || (frame == NULL)) {
+		LOG_ERR("[can_rx_manager] Invalid ISR callback parameters");
+		return;
+	}
+
+#if defined(CONFIG_CAN_RX_MANAGER_CAPTURE)
+	rp_can_rx_capture_put(mgr->data, frame);
+#endif
+	rp_can_rx_ingest(mgr, frame, &meta);
+}
+
+/**
+ * @brief Match a CAN frame against a software filter (standard/extended ID supported)
+ *
+ * @param filter Software filter to match against
+ * @param frame  Received CAN frame
+ * @return true  Frame matches the filter
+ * @return false Frame does not match
+ */
+static bool rp_can_rx_match(const struct can_filter *filter, const struct can_frame *frame)
+{
+	uint32_t frame_id = frame->id;
+	uint32_t filter_id = filter->id;
+
+	if (((frame->flags & CAN_FRAME_IDE) != 0U) != ((filter->flags & CAN_FILTER_IDE) != 0U)) {
+		return false;
+	}
+
+	if ((frame->flags & CAN_FRAME_IDE) != 0U) {
+		frame_id &= CAN_EXT_ID_MASK;
+		filter_id &= CAN_EXT_ID_MASK;
+	} else {
+		frame_id &= CAN_STD_ID_MASK;
+		filter_id &= CAN_STD_ID_MASK;
+	}
+	/* Compute masked values and log them for debugging */
+	uint32_t masked_frame = frame_id & filter->mask;
+	uint32_t masked_filter = filter_id & filter->mask;
+	if (masked_frame == masked_filter) {
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @brief Check whether a filter selects exactly one 11-bit standard ID
+ *
+ * @param filter Software filter
+ * @return true  Filter can be served by the direct-mapped ID table
+ * @return false Filter needs software matching
+ */
+static bool rp_can_rx_filter_is_exact_std(const struct can_filter *filter)
+{
+#if defined(CONFIG_CAN_RX_MANAGER_ID_TABLE)
+	return ((filter->flags & CAN_FILTER_IDE) == 0U) &&
+	       ((filter->mask & CAN_STD_ID_MASK) == CAN_STD_ID_MASK);
+#else
+	ARG_UNUSED(filter);
+	return false;
+#endif
+}
+
+/**
+ * @brief Call a listener's handler with the signature it registered
+ *
+ * @param data  Manager runtime data
+ * @param tbl   Table @p lst belongs to
+ * @param lst   Listener
+ * @param frame Received CAN frame
+ * @param meta  Reception metadata captured in the ISR
+ */
+static inline void rp_can_rx_call(struct rp_can_rx_manager_data *data, const struct rp_can_rx_table *tbl,
+				  const struct rp_can_rx_listener *lst, const struct can_frame *frame,
+				  const struct can_rx_meta *meta)
+{
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+	uint32_t start = k_cycle_get_32();
+#else
+	ARG_UNUSED(data);
+#endif
+#if !defined(CONFIG_CAN_RX_MANAGER_STATS_PER_LISTENER)
+	ARG_UNUSED(tbl);
+#endif
+	if ((lst->flags & CAN_RX_LISTENER_TIMESTAMP) != 0U) {
+		/* stored as can_rx_handler_t; the void (*)(void) step marks the cast as intended */
+		((can_rx_handler_ts_t)(void (*)(void))lst->handler)(frame, meta, lst->user_data);
+	} else {
+		lst->handler(frame, lst->user_data);
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+	uint32_t cyc = k_cycle_get_32() - start;
+	rp_can_rx_stats_add(data, &data->stats.handler, cyc);
+#if defined(CONFIG_CAN_RX_MANAGER_STATS_PER_LISTENER)
+	rp_can_rx_stats_add(data, &data->lst_stats[lst - tbl->listeners], cyc);
+#endif
+#endif
+}
+
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+/**
+ * @brief Overwrite a listener's mailbox with the newest frame (ISR context)
+ *
+ * @param data  Manager runtime data
+ * @param tbl   Table @p lst belongs to
+ * @param lst   CAN_RX_LISTENER_MAILBOX listener
+ * @param frame Received CAN frame
+ * @param meta  Reception metadata
+ */
+static void rp_can_rx_mailbox_post(struct rp_can_rx_manager_data *data, const struct rp_can_rx_table *tbl,
+				   const struct rp_can_rx_listener *lst, const struct can_frame *frame,
+				   const struct can_rx_meta *meta)
+{
+	struct rp_can_rx_mailbox *mb = &data->mbox[lst->mbox];
+
+	k_spinlock_key_t key = k_spin_lock(&data->mbox_lock);
+	if (mb->owner != (int16_t)(lst - tbl->listeners)) {
+		/* listener went away after this dispatch entered its table */
+		k_spin_unlock(&data->mbox_lock, key);
+		return;
+	}
+	if (mb->dirty) {
+		mb->coalesced++;
+		(void)atomic_inc(&data->mbox_coalesced);
+	} else {
+		mb->dirty = true;
+		data->mbox_dirty++;
+	}
+	mb->meta = *meta;
+	mb->frame = *frame;
+	k_spin_unlock(&data->mbox_lock, key);
+}
+
+/**
+ * @brief Deliver every dirty mailbox of a manager to its listener (RX thread context)
+ *
+ * @param data Manager runtime data
+ * @param tbl  Published table the caller has entered
+ */
+static void rp_can_rx_mailbox_drain(struct rp_can_rx_manager_data *data, const struct rp_can_rx_table *tbl)
+{
+	struct can_frame frame;
+	struct can_rx_meta meta;
+
+	for (int i = 0; i < CONFIG_CAN_RX_MANAGER_MAILBOX_NUM; i++) {
+		struct rp_can_rx_mailbox *mb = &data->mbox[i];
+		int16_t owner;
+
+		k_spinlock_key_t key = k_spin_lock(&data->mbox_lock);
+		owner = mb->owner;
+		if ((owner < 0) || !mb->dirty) {
+			k_spin_unlock(&data->mbox_lock, key);
+			continue;
+		}
+		frame = mb->frame;
+		meta = mb->meta;
+		mb->dirty = false;
+		data->mbox_dirty--;
+		k_spin_unlock(&data->mbox_lock, key);
+
+		const struct rp_can_rx_listener *lst = &tbl->listeners[owner];
+		if (!lst->used || (lst->mbox != i)) {
+			continue;	/* slot not published yet */
+		}
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+		/* a mailbox frame waits from its ISR arrival */
+		rp_can_rx_stats_add(data, &data->stats.queue, k_cycle_get_32() - meta.rx_cycles);
+#endif
+		rp_can_rx_call(data, tbl, lst, &frame, &meta);
+	}
+}
+#endif
+
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+/**
+ * @brief Late deadline of a tracker relative to its last frame, 0 while still learning
+ */
+static uint32_t rp_can_rx_live_late(const struct rp_can_rx_live *lv)
+{
+	if (lv->learned < CONFIG_CAN_RX_MANAGER_LIVENESS_LEARN) {
+		return 0U;
+	}
+	uint64_t late = (uint64_t)lv->period * CONFIG_CAN_RX_MANAGER_LIVENESS_LATE_PERIODS + 4U * (uint64_t)lv->jitter;
+
+	return (uint32_t)MIN(late, (uint64_t)INT32_MAX);
+}
+
+/**
+ * @brief Offline timeout of a tracker relative to its last frame, 0 if none is known yet
+ */
+static uint32_t rp_can_rx_live_timeout(const struct rp_can_rx_live *lv)
+{
+	if (lv->timeout != 0U) {
+		return lv->timeout;
+	}
+	if (lv->learned < CONFIG_CAN_RX_MANAGER_LIVENESS_LEARN) {
+		return 0U;
+	}
+	uint64_t timeout = (uint64_t)lv->period * CONFIG_CAN_RX_MANAGER_LIVENESS_OFFLINE_PERIODS;
+
+	return (uint32_t)MIN(timeout, (uint64_t)INT32_MAX);
+}
+
+/**
+ * @brief Learn from a frame delivered to a watched listener
+ *
+ * The period is a running mean over the first CAN_RX_MANAGER_LIVENESS_LEARN intervals,
+ * then an exponential average (1/8); the jitter is the RFC 3550 estimator (1/16) of the
+ * deviation from it. Intervals that end a late or offline phase are not learned from.
+ *
+ * @param data Manager runtime data
+ * @param slot Listener slot
+ * @param meta Reception metadata captured in the ISR
+ */
+static void rp_can_rx_live_feed(struct rp_can_rx_manager_data *data, int slot, const struct can_rx_meta *meta)
+{
+	int idx = data->live_idx[slot];
+
+	if (idx < 0) {
+		return;
+	}
+	struct rp_can_rx_live *lv = &data->live[idx];
+
+	k_spinlock_key_t key = k_spin_lock(&data->live_lock);
+	if (lv->owner != slot) {
+		k_spin_unlock(&data->live_lock, key);
+		return;
+	}
+	uint8_t prev = lv->state;
+	uint32_t interval = MIN(meta->rx_cycles - lv->last, (uint32_t)INT32_MAX);
+	bool rearm = (prev != CAN_RX_LIVE_ONLINE);	/* the timer may have nothing armed */
+
+	if ((prev == CAN_RX_LIVE_ONLINE) || (prev == CAN_RX_LIVE_LATE)) {
+		lv->min = MIN(lv->min, interval);
+		lv->max = MAX(lv->max, interval);
+	}
+	if (prev == CAN_RX_LIVE_ONLINE) {
+		int32_t d = (int32_t)interval - (int32_t)lv->period;
+
+		if (lv->learned > 0U) {
+			int32_t dev = (d < 0) ? -d : d;
+			lv->jitter = (uint32_t)((int32_t)lv->jitter + (dev - (int32_t)lv->jitter) / 16);
+		}
+		if (lv->learned < CONFIG_CAN_RX_MANAGER_LIVENESS_LEARN) {
+			lv->learned++;
+			lv->period = (uint32_t)((int32_t)lv->period + d / (int32_t)lv->learned);
+			rearm |= (lv->learned == CONFIG_CAN_RX_MANAGER_LIVENESS_LEARN);
+		} else {
+			lv->period = (uint32_t)((int32_t)lv->period + d / 8);
+		}
+	}
+	lv->last = meta->rx_cycles;
+	lv->frames++;
+	lv->state = CAN_RX_LIVE_ONLINE;
+	can_rx_liveness_cb_t cb = (prev != CAN_RX_LIVE_ONLINE) ? lv->cb : NULL;
+	void *user_data = lv->user_data;
+	k_spin_unlock(&data->live_lock, key);
+
+	if (cb != NULL) {
+		cb(slot, CAN_RX_LIVE_ONLINE, user_data);
+	}
+	if (rearm) {
+		k_timer_start(&data->live_timer, K_NO_WAIT, K_NO_WAIT);
+	}
+}
+
+/**
+ * @brief Check every tracker of a manager against its deadlines (timer ISR)
+ *
+ * Frames only move deadlines later, so the timer is not touched on arrival: it fires at the
+ * deadline it was armed for, finds most trackers refreshed, and rearms for the earliest
+ * deadline still ahead. One timer serves all watched listeners of the bus.
+ *
+ * @param timer live_timer of the manager
+ */
+static void rp_can_rx_live_expiry(struct k_timer *timer)
+{
+	struct rp_can_rx_manager_data *data = CONTAINER_OF(timer, struct rp_can_rx_manager_data, live_timer);
+	uint32_t next = UINT32_MAX;
+
+	for (int i = 0; i < CONFIG_CAN_RX_MANAGER_LIVENESS_NUM; i++) {
+		struct rp_can_rx_live *lv = &data->live[i];
+
+		k_spinlock_key_t key = k_spin_lock(&data->live_lock);
+		if ((lv->owner < 0) || (lv->state == CAN_RX_LIVE_OFFLINE)) {
+			k_spin_unlock(&data->live_lock, key);
+			continue;
+		}
+		uint32_t age = k_cycle_get_32() - lv->last;
+		uint32_t late = (lv->state == CAN_RX_LIVE_ONLINE) ? rp_can_rx_live_late(lv) : 0U;
+		uint32_t timeout = rp_can_rx_live_timeout(lv);
+		uint8_t prev = lv->state;
+
+		if ((timeout != 0U) && (age >= timeout)) {
+			lv->state = CAN_RX_LIVE_OFFLINE;
+			lv->offline++;
+		} else if ((late != 0U) && (age >= late)) {
+			lv->state = CAN_RX_LIVE_LATE;
+			lv->late++;
+		}
+		/* time to the nearest deadline still ahead */
+		if ((lv->state != CAN_RX_LIVE_OFFLINE) && (timeout != 0U)) {
+			next = MIN(next, timeout - age);
+		}
+		if ((lv->state == CAN_RX_LIVE_ONLINE) && (late != 0U)) {
+			next = MIN(next, late - age);
+		}
+		int slot = lv->owner;
+		enum can_rx_liveness state = (enum can_rx_liveness)lv->state;
+		can_rx_liveness_cb_t cb = (lv->state != prev) ? lv->cb : NULL;
+		void *user_data = lv->user_data;
+		k_spin_unlock(&data->live_lock, key);
+
+		if (cb != NULL) {
+			cb(slot, state, user_data);
+		}
+	}
+	if (next != UINT32_MAX) {
+		k_timer_start(timer, K_CYC(next), K_NO_WAIT);
+	}
+}
+#endif /* CONFIG_CAN_RX_MANAGER_LIVENESS */
+
+#if defined(CONFIG_CAN_RX_MANAGER_BUS_RECOVERY)
+/**
+ * @brief Close the period of the previous controller state and enter a new one
+ *
+ * Called with the health lock held.
+ *
+ * @param h     Health of the manager
+ * @param state New controller state, not CAN_STATE_STOPPED
+ * @return true if this ends a bus-off period
+ */
+static bool rp_can_rx_health_enter(struct rp_can_rx_health *h, enum can_state state)
+{
+	enum can_state prev = (enum can_state)atomic_get(&h->state);
+	int64_t now = k_uptime_ticks();
+
+	if (state == prev) {
+		return false;
+	}
+	if (prev == CAN_STATE_ERROR_PASSIVE) {
+		h->passive_ticks += now - h->since;
+	} else if (prev == CAN_STATE_BUS_OFF) {
+		h->off_ticks += now - h->since;
+	} else if ((prev == CAN_STATE_ERROR_ACTIVE) &&
+		   (now - h->since >= (int64_t)k_ms_to_ticks_ceil64(CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_HOLDOFF_MS))) {
+		h->settled = true;
+	}
+	int64_t off_start = h->since;
+
+	h->since = now;
+	atomic_set(&h->state, state);
+	if (state == CAN_STATE_ERROR_PASSIVE) {
+		h->error_passive++;
+	} else if (state == CAN_STATE_BUS_OFF) {
+		h->bus_off++;
+		h->off_cycles = k_cycle_get_32();
+		/* a flapping bus keeps growing the backoff, a bus that settled starts over */
+		h->backoff_ms = h->settled ? h->backoff_min :
+			MIN(h->backoff_ms * 2U, (uint32_t)CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_BACKOFF_MAX_MS);
+		h->settled = false;
+	}
+	if (prev != CAN_STATE_BUS_OFF) {
+		return false;
+	}
+
+	/* cycles resolve the usual millisecond outages, ticks the ones longer than a cycle wrap */
+	uint64_t us = k_ticks_to_us_floor64((uint64_t)(now - off_start));
+	if (us < USEC_PER_SEC) {
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - h->off_cycles);
+	}
+	h->last_us = (uint32_t)MIN(us, (uint64_t)UINT32_MAX);
+	h->max_us = MAX(h->max_us, h->last_us);
+	h->recoveries++;
+	return true;
+}
+
+/**
+ * @brief Delay before the recovery work steps in on a bus-off controller
+ *
+ * In manual recovery mode nothing happens until can_recover() is called, so the backoff
+ * applies as is. Otherwise the controller is already recovering by itself and a restart
+ * would throw that recovery away, so the work waits at least the grace period.
+ *
+ * @param h       Bus health of the manager
+ * @param can_dev CAN controller
+ * @param backoff Current backoff (ms)
+ * @return uint32_t Delay (ms)
+ */
+static uint32_t rp_can_rx_recover_delay(const struct rp_can_rx_health *h,
+					const struct device *can_dev, uint32_t backoff)
+{
+#if defined(CONFIG_CAN_MANUAL_RECOVERY_MODE)
+	if ((can_get_mode(can_dev) & CAN_MODE_MANUAL_RECOVERY) != 0U) {
+		return backoff;
+	}
+#else
+	ARG_UNUSED(can_dev);
+#endif
+	return MAX(backoff, h->grace_ms);
+}
+
+/**
+ * @brief Controller state change callback (CAN ISR)
+ *
+ * A bus-off controller normally recovers by itself after 128 x 11 recessive bits; the
+ * recovery work is only armed to step in if it does not. Bus-off is also what re-arms the
+ * work after it stopped polling a controller the application stopped.
+ *
+ * @param can_dev   CAN controller
+ * @param state     New state
+ * @param err_cnt   Error counters
+ * @param user_data Manager device
+ */
+static void rp_can_rx_state_cb(const struct device *can_dev, enum can_state state,
+			       struct can_bus_err_cnt err_cnt, void *user_data)
+{
+	const struct device *mgr = user_data;
+	struct rp_can_rx_manager_data *data = mgr->data;
+	struct rp_can_rx_health *h = &data->health;
+
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	h->err_cnt = err_cnt;
+	/* stops are requested by software, they say nothing about the bus */
+	bool recovered = (state != CAN_STATE_STOPPED) && rp_can_rx_health_enter(h, state);
+	uint32_t backoff = h->backoff_ms;
+	uint32_t last_us = h->last_us;
+	can_state_change_callback_t cb = h->cb;
+	void *cb_data = h->user_data;
+	k_spin_unlock(&h->lock, key);
+
+	if (state == CAN_STATE_BUS_OFF) {
+		(void)k_work_schedule(&h->work, K_MSEC(rp_can_rx_recover_delay(h, can_dev, backoff)));
+	} else if (recovered) {
+		(void)k_work_cancel_delayable(&h->work);
+		LOG_INF("[can_rx_manager] %s bus recovered after %u us", mgr->name, last_us);
+	}
+	if (cb != NULL) {
+		cb(can_dev, state, err_cnt, cb_data);
+	}
+}
+
+/**
+ * @brief Recover a controller that is still bus-off (system work queue)
+ *
+ * In manual recovery mode the recovery is requested with can_recover(); otherwise the
+ * controller is restarted, which only happens once the grace period of its own recovery has
+ * passed. Every attempt that leaves the bus off doubles the delay of the next one, up to
+ * CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_BACKOFF_MAX_MS. The work also closes bus-off periods
+ * the driver ended without a state change callback, and stops on a stopped controller.
+ *
+ * @param work recovery work of the manager
+ */
+static void rp_can_rx_recover_work(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct rp_can_rx_health *h = CONTAINER_OF(dwork, struct rp_can_rx_health, work);
+	const struct rp_can_rx_manager_cfg *cfg = h->mgr->config;
+	struct can_bus_err_cnt err_cnt;
+	enum can_state state;
+	k_spinlock_key_t key;
+
+	if (can_get_state(cfg->can_dev, &state, &err_cnt) != 0) {
+		state = CAN_STATE_BUS_OFF;
+	}
+	/* stopped by the application: nothing to recover, the next bus-off re-arms the work */
+	if (state == CAN_STATE_STOPPED) {
+		return;
+	}
+	if (state != CAN_STATE_BUS_OFF) {
+		key = k_spin_lock(&h->lock);
+		h->err_cnt = err_cnt;
+		bool recovered = rp_can_rx_health_enter(h, state);
+		uint32_t last_us = h->last_us;
+		k_spin_unlock(&h->lock, key);
+		if (recovered) {
+			LOG_INF("[can_rx_manager] %s bus recovered after %u us", h->mgr->name, last_us);
+		}
+		return;
+	}
+
+	key = k_spin_lock(&h->lock);
+	uint32_t backoff = h->backoff_ms;
+	h->backoff_ms = MIN(backoff * 2U, (uint32_t)CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_BACKOFF_MAX_MS);
+	uint32_t restarts = ++h->restarts;
+	k_spin_unlock(&h->lock, key);
+
+	int ret;
+	uint32_t delay = rp_can_rx_recover_delay(h, cfg->can_dev, backoff);
+#if defined(CONFIG_CAN_MANUAL_RECOVERY_MODE)
+	if ((can_get_mode(cfg->can_dev) & CAN_MODE_MANUAL_RECOVERY) != 0U) {
+		ret = can_recover(cfg->can_dev, K_NO_WAIT);
+	} else
+#endif
+	{
+		/* past the grace period: the automatic recovery is not going to finish */
+		(void)can_stop(cfg->can_dev);
+		ret = can_start(cfg->can_dev);
+	}
+	LOG_WRN("[can_rx_manager] %s still bus-off, restart %u: %d, next check in %u ms",
+		h->mgr->name, restarts, ret, delay);
+	(void)k_work_schedule(dwork, K_MSEC(delay));
+}
+#endif /* CONFIG_CAN_RX_MANAGER_BUS_RECOVERY */
+
+/**
+ * @brief Run a matching listener if it belongs to the current context
+ *
+ * In ISR context, mailbox listeners are served by storing the frame in their mailbox.
+ *
+ * @param data  Manager runtime data
+ * @param tbl   Table @p lst belongs to
+ * @param lst   Matching listener
+ * @param frame Received CAN frame
+ * @param meta  Reception metadata captured in the ISR
+ * @param ctx   RP_CAN_RX_CTX_ISR in the CAN RX ISR, else the class of the calling worker
+ * @return uint32_t BIT(class) if the listener needs the frame queued to its class worker,
+ *                  0 if it was delivered here or belongs to another worker
+ */
+static inline uint32_t rp_can_rx_invoke(struct rp_can_rx_manager_data *data, const struct rp_can_rx_table *tbl,
+					const struct rp_can_rx_listener *lst, const struct can_frame *frame,
+					const struct can_rx_meta *meta, int ctx)
+{
+	bool isr = (ctx == RP_CAN_RX_CTX_ISR);
+
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	if ((lst->flags & CAN_RX_LISTENER_MAILBOX) != 0U) {
+		if (isr) {
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+			rp_can_rx_live_feed(data, lst - tbl->listeners, meta);
+#endif
+			rp_can_rx_mailbox_post(data, tbl, lst, frame, meta);
+		}
+		return 0U;	/* never delivered from the queue */
+	}
+#endif
+	if ((lst->flags & CAN_RX_LISTENER_ISR) != 0U) {
+		if (!isr) {
+			return 0U;
+		}
+	} else {
+		int cls = (int)CAN_RX_LISTENER_CLASS_GET(lst->flags);
+
+		if (isr) {
+			return BIT(cls);
+		}
+		if (cls != ctx) {
+			return 0U;
+		}
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+	rp_can_rx_live_feed(data, lst - tbl->listeners, meta);
+#endif
+	rp_can_rx_call(data, tbl, lst, frame, meta);
+	return 0U;
+}
+
+/**
+ * @brief Invoke every listener of the current context whose filter matches the frame
+ *
+ * Exact standard-ID listeners are looked up in O(1) through the ID table; only the
+ * (usually short) fallback list of masked/extended filters is matched in software.
+ * The caller holds a read section on @p tbl, which no writer modifies while it is entered.
+ *
+ * @param data  Manager runtime data
+ * @param tbl   Published listener table
+ * @param frame Received CAN frame
+ * @param meta  Reception metadata captured in the ISR
+ * @param ctx   RP_CAN_RX_CTX_ISR in the RX ISR (run CAN_RX_LISTENER_ISR listeners), else
+ *              the class whose listeners the calling worker runs
+ * @return uint32_t Mask of the listener classes whose worker still needs the frame
+ *                  (only in ISR context)
+ */
+static uint32_t rp_can_rx_dispatch(struct rp_can_rx_manager_data *data, const struct rp_can_rx_table *tbl,
+				   const struct can_frame *frame, const struct can_rx_meta *meta, int ctx)
+{
+	uint32_t pending = 0U;
+
+#if defined(CONFIG_CAN_RX_MANAGER_ID_TABLE)
+	if ((frame->flags & CAN_FRAME_IDE) == 0U) {
+		rp_can_rx_slot_t idx = tbl->std_table[frame->id & CAN_STD_ID_MASK];
+		while (idx != RP_CAN_RX_SLOT_NONE) {
+			const struct rp_can_rx_listener *lst = &tbl->listeners[idx];
+			idx = lst->next;
+			pending |= rp_can_rx_invoke(data, tbl, lst, frame, meta, ctx);
+		}
+	}
+#endif
+	for (uint16_t n = 0; n < tbl->fallback_num; n++) {
+		const struct rp_can_rx_listener *lst = &tbl->listeners[tbl->fallback[n]];
+		if (!rp_can_rx_match(&lst->filter, frame)) {
+			continue;
+		}
+		pending |= rp_can_rx_invoke(data, tbl, lst, frame, meta, ctx);
+	}
+
+	return pending;
+}
+
+/**
+ * @brief Check whether a manager has frames (or, for class 0, mailboxes) waiting for a class worker
+ */
+static bool rp_can_rx_has_work(struct rp_can_rx_manager_data *data, int cls)
+{
+	if (atomic_get(&data->ring_head[cls]) != atomic_get(&data->ring_tail[cls])) {
+		return true;
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	if ((cls == 0) && (atomic_get(&data->mbox_doorbell) != 0)) {
+		return true;
+	}
+#endif
+	return false;
+}
+
+/**
+ * @brief Consume one contiguous batch of a class ring of a manager (and, for class 0, its dirty mailboxes)
+ *
+ * Records are copied into a frame of their received length and released with a single
+ * tail update, so a batch costs one index store instead of one queue operation per frame.
+ *
+ * @param mgr CAN RX manager device
+ * @param cls Listener class of the calling worker
+ * @return true  More work is pending (batch limit reached or new frames arrived)
+ * @return false Ring drained
+ */
+static bool rp_can_rx_drain(const struct device *mgr, int cls)
+{
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+	uint32_t ring_size = rp_can_rx_ring_len(cfg, cls);
+	/* one read section per batch; handlers may (un)register, which publishes the other table */
+	int gen = rp_can_rx_read_lock(data);
+	const struct rp_can_rx_table *tbl = &data->tables[gen];
+
+	atomic_set(&data->rx_held[cls], gen);
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	/* clear first: a frame posted while draining sets the doorbell again */
+	if ((cls == 0) && atomic_cas(&data->mbox_doorbell, 1, 0)) {
+		rp_can_rx_mailbox_drain(data, tbl);
+	}
+#endif
+
+	uint32_t tail = (uint32_t)atomic_get(&data->ring_tail[cls]);
+	uint32_t head = (uint32_t)atomic_get(&data->ring_head[cls]);
+	if (head == tail) {
+		atomic_set(&data->rx_held[cls], -1);
+		rp_can_rx_read_unlock(data, gen);
+		return false;
+	}
+
+	struct can_frame frame;
+	for (int n = 0; (n < CONFIG_CAN_RX_MANAGER_BATCH_LIMIT) && (tail != head); n++) {
+		const struct rp_can_rx_rec *rec = rp_can_rx_rec_at(cfg, cls, tail);
+
+		if ((ring_size - tail < sizeof(struct rp_can_rx_rec)) || (rec->dlc == RP_CAN_RX_REC_WRAP)) {
+			tail = 0U;
+			n--;			/* not a frame */
+			continue;
+		}
+		/* rebuild a struct can_frame with just the received payload */
+		frame.id = rec->id;
+		frame.dlc = rec->dlc;
+		frame.flags = rec->flags;
+#if defined(CONFIG_CAN_RX_TIMESTAMP)
+		frame.timestamp = rec->timestamp;
+#endif
+		uint8_t len = rp_can_rx_frame_len(&frame);
+		memcpy(frame.data, rec->data, len);
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+		rp_can_rx_stats_add(data, &data->stats.queue, k_cycle_get_32() - rec->enq_cycles);
+#endif
+		(void)rp_can_rx_dispatch(data, tbl, &frame, &rec->meta, cls);
+		tail += RP_CAN_RX_REC_SIZE(len);
+		if (tail == ring_size) {
+			tail = 0U;
+		}
+	}
+	/* release the whole batch with one store */
+	atomic_set(&data->ring_tail[cls], (atomic_val_t)tail);
+	atomic_set(&data->rx_held[cls], -1);
+	rp_can_rx_read_unlock(data, gen);
+
+#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
+	/* Report drops per-manager when threshold reached */
+	uint32_t drops = (uint32_t)atomic_get(&data->rx_dropped);
+	uint32_t last = data->last_reported_drops;
+	if (drops > last) {
+		uint32_t delta = drops - last;
+		if ((uint32_t)CONFIG_CAN_RX_MANAGER_MSGQ_WARN_EVERY_N_DROPS > 0 &&
+		    delta >= (uint32_t)CONFIG_CAN_RX_MANAGER_MSGQ_WARN_EVERY_N_DROPS) {
+			LOG_WRN("can_rx_manager(%p): %u frames dropped (cumulative)", mgr, drops);
+			data->last_reported_drops = drops;
+		}
+	}
+#endif
+
+	return rp_can_rx_has_work(data, cls);
+}
+
+/**
+ * @brief RX processing thread of one listener class, either shared by several CAN manager
+ *        instances or dedicated to one
+ *
+ * @param p1 Managers drained by this thread (const struct device *const *)
+ * @param p2 Number of managers
+ * @param p3 Listener class served
+ */
+static void rp_can_rx_thread(void *p1, void *p2, void *p3)
+{
+	const struct device *const *devs = (const struct device *const *)p1;
+	size_t dev_num = (size_t)(uintptr_t)p2;
+	int cls = (int)(uintptr_t)p3;
+	const struct rp_can_rx_manager_cfg *cfg = devs[0]->config;	/* all share one sem/idle pair per class */
+
+	for (size_t d = 0; d < dev_num; d++) {
+		((struct rp_can_rx_manager_data *)devs[d]->data)->rx_tid[cls] = k_current_get();
+	}
+
+	while (true) {
+		bool more = false;
+		for (size_t d = 0; d < dev_num; d++) {
+			more |= rp_can_rx_drain(devs[d], cls);
+		}
+		if (more) {
+			/* batch limit reached: let equal-priority threads run, then continue */
+			k_yield();
+			continue;
+		}
+
+		/* Announce sleep, then re-check: a producer either sees the flag or published before it */
+		atomic_set(&cfg->rx_idle[cls], 1);
+		for (size_t d = 0; d < dev_num; d++) {
+			more |= rp_can_rx_has_work(devs[d]->data, cls);
+		}
+		if (more) {
+			atomic_set(&cfg->rx_idle[cls], 0);
+			continue;
+		}
+		k_sem_take(&cfg->rx_sem[cls], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Hook a listener slot into the ID table or the fallback list
+ *
+ * @param tbl Unpublished listener table
+ * @param idx Listener slot, already filled in
+ */
+static void rp_can_rx_link(struct rp_can_rx_table *tbl, int idx)
+{
+	const struct can_filter *filter = &tbl->listeners[idx].filter;
+
+	if (rp_can_rx_filter_is_exact_std(filter)) {
+#if defined(CONFIG_CAN_RX_MANAGER_ID_TABLE)
+		/* append to the tail of the ID chain to keep registration order */
+		rp_can_rx_slot_t *link = &tbl->std_table[filter->id & CAN_STD_ID_MASK];
+		while (*link != RP_CAN_RX_SLOT_NONE) {
+			link = &tbl->listeners[*link].next;
+		}
+		*link = (rp_can_rx_slot_t)idx;
+#endif
+	} else {
+		tbl->fallback[tbl->fallback_num++] = (rp_can_rx_slot_t)idx;
+	}
+}
+
+/**
+ * @brief Remove a listener slot from the ID table or the fallback list
+ *
+ * @param tbl Unpublished listener table
+ * @param idx Listener slot
+ */
+static void rp_can_rx_unlink(struct rp_can_rx_table *tbl, int idx)
+{
+	struct rp_can_rx_listener *lst = &tbl->listeners[idx];
+
+	if (rp_can_rx_filter_is_exact_std(&lst->filter)) {
+#if defined(CONFIG_CAN_RX_MANAGER_ID_TABLE)
+		rp_can_rx_slot_t *link = &tbl->std_table[lst->filter.id & CAN_STD_ID_MASK];
+		while ((*link != RP_CAN_RX_SLOT_NONE) && (*link != (rp_can_rx_slot_t)idx)) {
+			link = &tbl->listeners[*link].next;
+		}
+		if (*link != RP_CAN_RX_SLOT_NONE) {
+			*link = lst->next;
+		}
+#endif
+		return;
+	}
+
+	for (uint16_t n = 0; n < tbl->fallback_num; n++) {
+		if (tbl->fallback[n] != (rp_can_rx_slot_t)idx) {
+			continue;
+		}
+		/* keep the remaining fallback listeners in registration order */
+		memmove(&tbl->fallback[n], &tbl->fallback[n + 1],
+			(tbl->fallback_num - n - 1U) * sizeof(tbl->fallback[0]));
+		tbl->fallback_num--;
+		break;
+	}
+}
+
+/**
+ * @brief Check whether the caller is a handler running in one of the manager's RX threads
+ *
+ * Such a caller is inside a read section of the table it dispatches from and must not wait
+ * for that table to be released.
+ */
+static bool rp_can_rx_in_own_dispatch(const struct device *mgr, int gen)
+{
+	struct rp_can_rx_manager_data *data = mgr->data;
+
+	for (int cls = 0; cls < RP_CAN_RX_CLASSES; cls++) {
+		if (k_current_get() == data->rx_tid[cls]) {
+			return atomic_get(&data->rx_held[cls]) == gen;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Start a listener table update: copy the published table into the spare one
+ *
+ * Waits until no dispatch is still inside the spare table (the grace period of the previous
+ * update). Must be called with reg_lock held.
+ *
+ * @param mgr CAN RX manager device
+ * @param tbl Spare table to edit, then pass to rp_can_rx_table_publish()
+ * @return int 0 on success, -EBUSY if the caller itself still dispatches from the spare table
+ */
+static int rp_can_rx_table_edit(const struct device *mgr, struct rp_can_rx_table **tbl)
+{
+	struct rp_can_rx_manager_data *data = mgr->data;
+	int cur = (int)atomic_get(&data->active);
+	int nxt = cur ^ 1;
+
+	while (atomic_get(&data->readers[nxt]) != 0) {
+		if (rp_can_rx_in_own_dispatch(mgr, nxt)) {
+			return -EBUSY;
+		}
+		k_msleep(1);
+	}
+	memcpy(&data->tables[nxt], &data->tables[cur], sizeof(data->tables[nxt]));
+	*tbl = &data->tables[nxt];
+	return 0;
+}
+
+/**
+ * @brief Publish an edited table and wait for dispatches still using the old one
+ *
+ * Once this returns, no handler removed by the update runs any more, except for the one
+ * the calling RX thread is currently executing.
+ *
+ * @param mgr CAN RX manager device
+ */
+static void rp_can_rx_table_publish(const struct device *mgr)
+{
+	struct rp_can_rx_manager_data *data = mgr->data;
+	int old = (int)atomic_get(&data->active);
+
+	atomic_set(&data->active, old ^ 1);
+	while (atomic_get(&data->readers[old]) != 0) {
+		if (rp_can_rx_in_own_dispatch(mgr, old)) {
+			break;	/* released when the calling handler returns */
+		}
+		k_msleep(1);
+	}
+}
+
+#if defined(CONFIG_CAN_RX_MANAGER_HW_FILTER)
+/**
+ * @brief Number of IDs accepted by a mask filter (2^free bits)
+ */
+static uint64_t rp_can_rx_hw_span(uint32_t mask, uint32_t id_mask)
+{
+	return 1ULL << POPCOUNT(id_mask & ~mask);
+}
+
+/**
+ * @brief Greedily merge mask filters until they fit into the hardware budget
+ *
+ * Each step merges the pair whose combined filter admits the fewest IDs that neither
+ * of them accepted before. Pairs that cost nothing (duplicates, covered filters, IDs
+ * that only differ in one bit) are always merged, so adjacent motor IDs collapse
+ * into a single mask filter even when the budget is not exhausted.
+ *
+ * @param set     Filters of one ID type, modified in place
+ * @param num     Number of filters in @p set
+ * @param budget  Hardware filter elements available for this ID type
+ * @param id_mask CAN_STD_ID_MASK or CAN_EXT_ID_MASK
+ * @return int    Number of filters left in @p set
+ */
+static int rp_can_rx_hw_merge(struct can_filter *set, int num, int budget, uint32_t id_mask)
+{
+	while (num > 1) {
+		int best_i = 0;
+		int best_j = 1;
+		int64_t best_cost = INT64_MAX;
+
+		for (int i = 0; i < num; i++) {
+			for (int j = i + 1; j < num; j++) {
+				uint32_t mask = set[i].mask & set[j].mask & ~(set[i].id ^ set[j].id);
+				int64_t cost = (int64_t)rp_can_rx_hw_span(mask, id_mask) -
+					       (int64_t)rp_can_rx_hw_span(set[i].mask, id_mask) -
+					       (int64_t)rp_can_rx_hw_span(set[j].mask, id_mask);
+				if (cost < best_cost) {
+					best_cost = cost;
+					best_i = i;
+					best_j = j;
+				}
+			}
+		}
+
+		if ((num <= budget) && (best_cost > 0)) {
+			break;
+		}
+
+		set[best_i].mask &= ~(set[best_i].id ^ set[best_j].id);
+		set[best_i].id &= set[best_i].mask;
+		set[best_j] = set[--num];
+	}
+
+	return num;
+}
+
+/**
+ * @brief Hardware filter elements available for one ID type on a CAN controller
+ *
+ * The controller's own element count (`bosch,mram-cfg` on MCAN) is the budget. The Kconfig
+ * numbers only size the per-manager storage and are checked against the devicetree at build
+ * time; they stand in for drivers that cannot report their filter count.
+ */
+static int rp_can_rx_hw_budget(const struct device *can_dev, bool ide)
+{
+	int storage = ide ? CONFIG_CAN_MCAN_EX_FILTERS_NBR : CONFIG_CAN_MCAN_SD_FILTERS_NBR;
+	int max = can_get_max_filters(can_dev, ide);
+
+	return (max < 0) ? storage : MIN(max, storage);
+}
+
+/**
+ * @brief Compile the registered listener filters of one ID type into hardware filters
+ *
+ * @param mgr  CAN RX manager device
+ * @param tbl  Listener table to compile
+ * @param ide  true for extended, false for standard IDs
+ * @param out  Output array, at least RP_CAN_RX_HW_FILTERS_MAX entries
+ * @param used Number of entries of @p out already filled; updated on return
+ * @return true  Listeners of this ID type exist
+ * @return false No listener of this ID type is registered
+ */
+static bool rp_can_rx_hw_compile(const struct device *mgr, const struct rp_can_rx_table *tbl, bool ide,
+				 struct can_filter *out, int *used)
+{
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+	uint32_t id_mask = ide ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK;
+	int num = 0;
+
+	for (int i = 0; i < CONFIG_CAN_RX_MANAGER_MAX_LISTENERS; i++) {
+		const struct rp_can_rx_listener *lst = &tbl->listeners[i];
+		if (!lst->used || (((lst->filter.flags & CAN_FILTER_IDE) != 0U) != ide)) {
+			continue;
+		}
+		data->hw_scratch[num].mask = lst->filter.mask & id_mask;
+		data->hw_scratch[num].id = lst->filter.id & data->hw_scratch[num].mask;
+		data->hw_scratch[num].flags = ide ? CAN_FILTER_IDE : 0U;
+		num++;
+	}
+	if (num == 0) {
+		return false;
+	}
+
+	int budget = rp_can_rx_hw_budget(cfg->can_dev, ide);
+	if (budget <= 0) {
+		return false;	/* registration refuses such listeners, never reached */
+	}
+	num = rp_can_rx_hw_merge(data->hw_scratch, num, budget, id_mask);
+	memcpy(&out[*used], data->hw_scratch, (size_t)num * sizeof(out[0]));
+	*used += num;
+	return true;
+}
+
+/**
+ * @brief Remove every hardware filter currently owned by the manager
+ */
+static void rp_can_rx_hw_remove_all(const struct device *mgr)
+{
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+
+	for (int i = 0; i < data->hw_filter_num; i++) {
+		can_remove_rx_filter(cfg->can_dev, data->hw_filter_ids[i]);
+	}
+	data->hw_filter_num = 0;
+}
+
+/**
+ * @brief Reprogram the controller acceptance filters from the registered listeners
+ *
+ * New filters are installed before the old ones are removed so no wanted frame is lost
+ * while listeners change. If the controller runs out of filter elements, the manager
+ * falls back to one accept-all filter per ID type and relies on software matching.
+ * Must be called with reg_lock held.
+ *
+ * @param mgr CAN RX manager device
+ * @param tbl Listener table about to be published
+ * @return int 0 on success, negative error code on failure
+ */
+static int rp_can_rx_hw_filters_apply(const struct device *mgr, const struct rp_can_rx_table *tbl)
+{
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+	struct can_filter hw[RP_CAN_RX_HW_FILTERS_MAX];
+	int ids[RP_CAN_RX_HW_FILTERS_MAX];
+	int num = 0;
+	int added = 0;
+	bool old_removed = false;
+	int ret = 0;
+
+	bool want_std = rp_can_rx_hw_compile(mgr, tbl, false, hw, &num);
+	bool want_ext = rp_can_rx_hw_compile(mgr, tbl, true, hw, &num);
+
+	for (added = 0; added < num; added++) {
+		ret = can_add_rx_filter(cfg->can_dev, rp_can_rx_isr_cb, (void *)mgr, &hw[added]);
+		if ((ret == -ENOSPC) && !old_removed) {
+			/* no headroom for make-before-break: free our old elements first */
+			rp_can_rx_hw_remove_all(mgr);
+			old_removed = true;
+			ret = can_add_rx_filter(cfg->can_dev, rp_can_rx_isr_cb, (void *)mgr, &hw[added]);
+		}
+		if (ret < 0) {
+			break;
+		}
+		ids[added] = ret;
+	}
+
+	if (ret < 0) {
+		LOG_WRN("can_rx_manager(%s): hardware filters exhausted (%d), falling back to software matching",
+			mgr->name, ret);
+		for (int i = 0; i < added; i++) {
+			can_remove_rx_filter(cfg->can_dev, ids[i]);
+		}
+		rp_can_rx_hw_remove_all(mgr);
+
+		added = 0;
+		num = 0;
+		if (want_std) {
+			hw[num++] = (struct can_filter){.id = 0, .mask = 0, .flags = 0};
+		}
+		if (want_ext) {
+			hw[num++] = (struct can_filter){.id = 0, .mask = 0, .flags = CAN_FILTER_IDE};
+		}
+		for (added = 0; added < num; added++) {
+			ret = can_add_rx_filter(cfg->can_dev, rp_can_rx_isr_cb, (void *)mgr, &hw[added]);
+			if (ret < 0) {
+				LOG_ERR("can_rx_manager(%s): cannot install accept-all filter: %d", mgr->name, ret);
+				break;
+			}
+			ids[added] = ret;
+		}
+	} else if (!old_removed) {
+		rp_can_rx_hw_remove_all(mgr);
+	}
+
+	memcpy(data->hw_filter_ids, ids, (size_t)added * sizeof(ids[0]));
+	data->hw_filter_num = (uint8_t)added;
+	LOG_DBG("can_rx_manager(%s): %d hardware filter(s) installed", mgr->name, added);
+
+	return (ret < 0) ? ret : 0;
+}
+#endif /* CONFIG_CAN_RX_MANAGER_HW_FILTER */
+
+/**
+ * @brief Register a software RX listener. All CAN devices must register here before
+ *        receiving frames through the manager.
+ *
+ * @param mgr       CAN RX manager device
+ * @param filter    Software filter for frame matching
+ * @param handler   Callback invoked when a matching frame is received (a
+ *                  can_rx_handler_ts_t when flags has CAN_RX_LISTENER_TIMESTAMP)
+ * @param user_data Opaque pointer passed to the handler
+ * @param flags     CAN_RX_LISTENER_* flags
+ * @return int      Listener ID on success, negative error code on failure; -EBUSY when a
+ *                  handler makes a second change within one RX batch, -ENOSPC with
+ *                  CONFIG_CAN_RX_MANAGER_HW_FILTER when the controller has no filter
+ *                  element for the ID type of @p filter
+ */
+int rp_can_rx_manager_register(const struct device *mgr, const struct can_filter *filter,
+			      can_rx_handler_t handler, void *user_data, uint32_t flags)
+{
+	if ((mgr == NULL) || (filter == NULL) || (handler == NULL)) {
+		return -EINVAL;
+	}
+	if (!device_is_ready(mgr)) {
+		return -ENODEV;
+	}
+
+	struct rp_can_rx_manager_data *data = mgr->data;
+	if (data == NULL) {
+		return -EINVAL;
+	}
+
+	uint32_t cls = CAN_RX_LISTENER_CLASS_GET(flags);
+	/* ISR and mailbox listeners are served at interrupt time and by the class 0 worker */
+	if ((cls >= RP_CAN_RX_CLASSES) ||
+	    ((cls != 0U) && ((flags & (CAN_RX_LISTENER_ISR | CAN_RX_LISTENER_MAILBOX)) != 0U))) {
+		return -EINVAL;
+	}
+	if ((flags & CAN_RX_LISTENER_MAILBOX) != 0U) {
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+		uint32_t id_mask = ((filter->flags & CAN_FILTER_IDE) != 0U) ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK;
+		/* one slot per listener: a masked filter would coalesce different IDs */
+		if (((flags & CAN_RX_LISTENER_ISR) != 0U) || ((filter->mask & id_mask) != id_mask)) {
+			return -EINVAL;
+		}
+#else
+		return -ENOTSUP;
+#endif
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_HW_FILTER)
+	/* the controller only passes frames its filter elements accept: such a listener would be deaf */
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	bool ide = ((filter->flags & CAN_FILTER_IDE) != 0U);
+	if (rp_can_rx_hw_budget(cfg->can_dev, ide) <= 0) {
+		LOG_ERR("can_rx_manager(%s): %s has no %s filter elements", mgr->name,
+			cfg->can_dev->name, ide ? "extended" : "standard");
+		return -ENOSPC;
+	}
+#endif
+
+	k_mutex_lock(&data->reg_lock, K_FOREVER);
+	/* only writers change the tables and they hold reg_lock: the published one is stable here */
+	const struct rp_can_rx_table *cur = &data->tables[atomic_get(&data->active)];
+	int i;
+
+	for (i = 0; i < CONFIG_CAN_RX_MANAGER_MAX_LISTENERS; i++) {
+		if (!cur->listeners[i].used) {
+			break;
+		}
+	}
+	if (i == CONFIG_CAN_RX_MANAGER_MAX_LISTENERS) {
+		k_mutex_unlock(&data->reg_lock);
+		return -ENOSPC;
+	}
+
+	struct rp_can_rx_table *tbl;
+	int ret = rp_can_rx_table_edit(mgr, &tbl);
+	if (ret < 0) {
+		k_mutex_unlock(&data->reg_lock);
+		return ret;
+	}
+
+	struct rp_can_rx_listener *lst = &tbl->listeners[i];
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	int16_t mbox = -1;
+	if ((flags & CAN_RX_LISTENER_MAILBOX) != 0U) {
+		for (int m = 0; m < CONFIG_CAN_RX_MANAGER_MAILBOX_NUM; m++) {
+			if (data->mbox[m].owner < 0) {
+				mbox = (int16_t)m;
+				break;
+			}
+		}
+		if (mbox < 0) {
+			k_mutex_unlock(&data->reg_lock);
+			return -ENOSPC;
+		}
+		data->mbox[mbox].dirty = false;
+		data->mbox[mbox].coalesced = 0U;
+		data->mbox[mbox].owner = (int16_t)i;
+	}
+	lst->mbox = mbox;
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_STATS_PER_LISTENER)
+	memset(&data->lst_stats[i], 0, sizeof(data->lst_stats[i]));	/* slot may be reused */
+#endif
+	lst->filter = *filter;
+	lst->handler = handler;
+	lst->user_data = user_data;
+	lst->flags = flags;
+	lst->next = RP_CAN_RX_SLOT_NONE;
+	lst->used = true;
+	rp_can_rx_link(tbl, i);
+	if ((flags & (CAN_RX_LISTENER_ISR | CAN_RX_LISTENER_MAILBOX)) != 0U) {
+		tbl->isr_num++;
+	} else if (cls != 0U) {
+		tbl->routed_num++;
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_HW_FILTER)
+	(void)rp_can_rx_hw_filters_apply(mgr, tbl);
+#endif
+	/* the listener is complete before any dispatch can reach it */
+	rp_can_rx_table_publish(mgr);
+	LOG_INF("can_rx_manager: registered listener id=%d filter_id=0x%03x mask=0x%03x", i, (unsigned int)filter->id, (unsigned int)filter->mask);
+	k_mutex_unlock(&data->reg_lock);
+	return i;
+}
+
+/**
+ * @brief Unregister a previously registered listener
+ *
+ * Returns once no dispatch can call the handler any more, so its user_data may be released
+ * right after (unless called from that handler itself).
+ *
+ * @param mgr         CAN RX manager device
+ * @param listener_id Listener ID returned by rp_can_rx_manager_register()
+ * @return int        0 on success, negative error code on failure
+ */
+int rp_can_rx_manager_unregister(const struct device *mgr, int listener_id)
+{
+	if ((mgr == NULL) || (listener_id < 0) || (listener_id >= CONFIG_CAN_RX_MANAGER_MAX_LISTENERS)) {
+		return -EINVAL;
+	}
+	if (!device_is_ready(mgr)) {
+		return -ENODEV;
+	}
+
+	struct rp_can_rx_manager_data *data = mgr->data;
+	if (data == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&data->reg_lock, K_FOREVER);
+	if (!data->tables[atomic_get(&data->active)].listeners[listener_id].used) {
+		k_mutex_unlock(&data->reg_lock);
+		return -ENOENT;
+	}
+
+	struct rp_can_rx_table *tbl;
+	int ret = rp_can_rx_table_edit(mgr, &tbl);
+	if (ret < 0) {
+		k_mutex_unlock(&data->reg_lock);
+		return ret;
+	}
+
+	struct rp_can_rx_listener *lst = &tbl->listeners[listener_id];
+	rp_can_rx_unlink(tbl, listener_id);
+	if ((lst->flags & (CAN_RX_LISTENER_ISR | CAN_RX_LISTENER_MAILBOX)) != 0U) {
+		tbl->isr_num--;
+	} else if (CAN_RX_LISTENER_CLASS_GET(lst->flags) != 0U) {
+		tbl->routed_num--;
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	int16_t mbox = lst->mbox;
+#endif
+	memset(lst, 0, sizeof(*lst));
+	lst->next = RP_CAN_RX_SLOT_NONE;
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	lst->mbox = -1;
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_HW_FILTER)
+	(void)rp_can_rx_hw_filters_apply(mgr, tbl);
+#endif
+	/* after the grace period the handler and its user_data are no longer referenced */
+	rp_can_rx_table_publish(mgr);
+
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	if (mbox >= 0) {
+		k_spinlock_key_t key = k_spin_lock(&data->mbox_lock);
+		if (data->mbox[mbox].dirty) {
+			data->mbox_dirty--;
+		}
+		data->mbox[mbox].dirty = false;
+		data->mbox[mbox].owner = -1;
+		k_spin_unlock(&data->mbox_lock, key);
+	}
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+	k_spinlock_key_t lkey = k_spin_lock(&data->live_lock);
+	if (data->live_idx[listener_id] >= 0) {
+		data->live[data->live_idx[listener_id]].owner = -1;
+		data->live_idx[listener_id] = -1;
+	}
+	k_spin_unlock(&data->live_lock, lkey);
+#endif
+	k_mutex_unlock(&data->reg_lock);
+	return 0;
+}
+
+
+/**
+ * @brief CAN RX manager driver initialization
+ *
+ * @param dev Device instance
+ * @return int 0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_init(const struct device *dev)
+{
+	const struct rp_can_rx_manager_cfg *cfg = dev->config;
+	struct rp_can_rx_manager_data *data = dev->data;
+
+	if ((cfg == NULL) || (data == NULL)) {
+		LOG_ERR("[can_rx_manager] init failed - invalid config or data");
+		return -EINVAL;
+	}
+	if (!device_is_ready(cfg->can_dev)) {
+		LOG_ERR("[can_rx_manager] init failed - CAN device not ready");
+		return -ENODEV;
+	}
+
+	/* Empty dispatch structures: every ID-table entry points at no listener */
+	for (size_t t = 0; t < ARRAY_SIZE(data->tables); t++) {
+#if defined(CONFIG_CAN_RX_MANAGER_ID_TABLE)
+		memset(data->tables[t].std_table, 0xFF, sizeof(data->tables[t].std_table));
+#endif
+		data->tables[t].fallback_num = 0;
+		data->tables[t].isr_num = 0;
+		data->tables[t].routed_num = 0;
+		atomic_set(&data->readers[t], 0);
+	}
+	atomic_set(&data->active, 0);
+	for (int cls = 0; cls < RP_CAN_RX_CLASSES; cls++) {
+		atomic_set(&data->rx_held[cls], -1);
+		atomic_set(&data->ring_head[cls], 0);
+		atomic_set(&data->ring_tail[cls], 0);
+	}
+
+	/* Wakeup semaphores before any filter: the ISR may queue frames right away */
+#if RP_CAN_RX_MGR_SHARED_USERS > 0
+	bool shared_first = !cfg->dedicated_rx_thread && atomic_cas(&rp_can_rx_shared_started, 0, 1);
+#else
+	bool shared_first = false;
+#endif
+	if (cfg->dedicated_rx_thread || shared_first) {
+		for (int cls = 0; cls < RP_CAN_RX_CLASSES; cls++) {
+			k_sem_init(&cfg->rx_sem[cls], 0, 1);
+		}
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	for (int i = 0; i < CONFIG_CAN_RX_MANAGER_MAILBOX_NUM; i++) {
+		data->mbox[i].owner = -1;
+	}
+	atomic_set(&data->mbox_doorbell, 0);
+	atomic_set(&data->mbox_coalesced, 0);
+	data->mbox_dirty = 0;
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+	for (int i = 0; i < CONFIG_CAN_RX_MANAGER_LIVENESS_NUM; i++) {
+		data->live[i].owner = -1;
+	}
+	for (int i = 0; i < CONFIG_CAN_RX_MANAGER_MAX_LISTENERS; i++) {
+		data->live_idx[i] = -1;
+	}
+	k_timer_init(&data->live_timer, rp_can_rx_live_expiry, NULL);
+#endif
+
+#if defined(CONFIG_CAN_FD_MODE)
+	/* Accept CAN-FD frames as well; the controller is still stopped after its own init */
+	can_mode_t cap;
+	if ((can_get_capabilities(cfg->can_dev, &cap) == 0) && ((cap & CAN_MODE_FD) != 0U)) {
+		(void)can_set_mode(cfg->can_dev, can_get_mode(cfg->can_dev) | CAN_MODE_FD);
+	}
+#endif
+
+#if defined(CONFIG_CAN_RX_MANAGER_BUS_RECOVERY)
+	/* Bus-off recovery takes 128 x 11 recessive bits; never restart before that */
+	data->health.mgr = dev;
+	atomic_set(&data->health.state, CAN_STATE_ERROR_ACTIVE);
+	data->health.since = k_uptime_ticks();
+	data->health.backoff_min = MAX((uint32_t)CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_BACKOFF_MIN_MS,
+				       DIV_ROUND_UP(128U * 11U * MSEC_PER_SEC, cfg->bitrate) + 1U);
+	data->health.backoff_ms = data->health.backoff_min;
+	/* with traffic each 11-bit recessive sequence can wait for a whole frame of the others */
+	data->health.grace_ms = MAX((uint32_t)CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_GRACE_MS,
+				    DIV_ROUND_UP(128U * 160U * MSEC_PER_SEC, cfg->bitrate) + 1U);
+	data->health.settled = true;
+	k_work_init_delayable(&data->health.work, rp_can_rx_recover_work);
+	can_set_state_change_callback(cfg->can_dev, rp_can_rx_state_cb, (void *)dev);
+#endif
+
+	int ret = can_start(cfg->can_dev); // 启动 CAN 设备,
+	if ((ret < 0) && (ret != -EALREADY))
+	{
+		rp_can_rx_shared_unclaim(shared_first);
+		return ret;
+	}
+
+	k_mutex_init(&data->reg_lock);
+	data->hw_filter_num = 0;
+#if !defined(CONFIG_CAN_RX_MANAGER_HW_FILTER)
+	/* One broad hardware filter: accept all standard IDs into the manager ring */
+	const struct can_filter hw = {
+		.id = 0,
+		.mask = 0,
+		.flags = 0,
+	};
+
+	/* Register a single ISR callback that will enqueue into the manager ring */
+	ret = can_add_rx_filter(cfg->can_dev, rp_can_rx_isr_cb, (void *)dev, &hw);
+	if (ret < 0) {
+		rp_can_rx_shared_unclaim(shared_first);
+		return ret;
+	}
+	data->hw_filter_ids[0] = ret;
+	data->hw_filter_num = 1;
+#endif
+	/* With CONFIG_CAN_RX_MANAGER_HW_FILTER, filters are installed as listeners register */
+
+	/* Start the shared processing thread once */
+	/* Initialize monitoring counters if enabled */
+#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
+	atomic_set(&data->rx_dropped, 0);
+	atomic_set(&data->rx_queued, 0);
+	for (int cls = 0; cls < RP_CAN_RX_CLASSES; cls++) {
+		atomic_set(&data->ring_hwm[cls], 0);
+	}
+	data->last_reported_drops = 0;
+#endif
+	if (!cfg->dedicated_rx_thread && !shared_first) {
+		return 0;
+	}
+	/*
+	 * Per-bus mode: this instance drains its own rings at its own priority. Shared mode: the
+	 * first instance starts the workers of all shared instances. One worker per class, each
+	 * class RP_CAN_RX_CLASS_PRIO_STEP levels below the previous one.
+	 */
+#if RP_CAN_RX_MGR_SHARED_USERS > 0
+	struct k_thread *threads = cfg->dedicated_rx_thread ? data->rx_thread : rp_can_rx_shared_thread_data;
+	const char *name = cfg->dedicated_rx_thread ? dev->name : "can_rx_mgr";
+#else
+	struct k_thread *threads = data->rx_thread;
+	const char *name = dev->name;
+#endif
+	for (int cls = 0; cls < RP_CAN_RX_CLASSES; cls++) {
+		char label[CONFIG_THREAD_MAX_NAME_LEN];
+
+		k_thread_create(&threads[cls], cfg->rx_stack + cls * cfg->rx_stack_len, cfg->rx_stack_size,
+				rp_can_rx_thread, (void *)cfg->rx_devs, (void *)(uintptr_t)cfg->rx_dev_num,
+				(void *)(uintptr_t)cls, cfg->rx_thread_prio + cls * RP_CAN_RX_CLASS_PRIO_STEP, 0,
+				K_NO_WAIT);
+		if (cls == 0) {
+			k_thread_name_set(&threads[cls], name);
+		} else {
+			snprintk(label, sizeof(label), "%s/%d", name, cls);
+			k_thread_name_set(&threads[cls], label);
+		}
+	}
+
+	return 0;
+}
+
+/* Sums of the slices inside the sliding window */
+struct rp_can_bus_window {
+	uint32_t window_ms;
+	uint32_t frames[2];
+	uint64_t bits_nominal;
+	uint64_t bits_data;
+	uint32_t valid;			/* bitmask of the slice indexes inside the window */
+};
+
+/**
+ * @brief Sum the bus statistics window; read-only, callable by any number of readers
+ *
+ * @param data Manager runtime data, bus_lock held
+ * @param now  Current uptime in milliseconds
+ * @param win  Output sums
+ */
+static void rp_can_bus_window_get(const struct rp_can_rx_manager_data *data, int64_t now,
+				  struct rp_can_bus_window *win)
+{
+	uint32_t epoch = (uint32_t)(now / CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICE_MS);
+	uint64_t span = (uint64_t)(CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES - 1) *
+			CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICE_MS +
+			(uint64_t)(now % CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICE_MS);
+
+	memset(win, 0, sizeof(*win));
+	win->window_ms = (uint32_t)MAX(MIN(span, (uint64_t)now), 1U);
+	for (int i = 0; i < CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES; i++) {
+		const struct rp_can_bus_slice *sl = &data->bus_slice[i];
+
+		/* stale slices are only cleared by the next frame */
+		if ((epoch - sl->epoch) >= (uint32_t)CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES) {
+			continue;
+		}
+		win->valid |= BIT(i);
+		for (int dir = RP_CAN_BUS_RX; dir <= RP_CAN_BUS_TX; dir++) {
+			win->frames[dir] += sl->frames[dir];
+			win->bits_nominal += sl->bits_nominal[dir];
+			win->bits_data += sl->bits_data[dir];
+		}
+	}
+}
+
+/**
+ * @brief Bus time in microseconds taken by a number of nominal and data-phase bits
+ */
+static uint64_t rp_can_bus_busy_us(uint64_t bits_nominal, uint64_t bits_data, uint32_t nominal_bps,
+				   uint32_t data_bps)
+{
+	if (data_bps == 0U) {
+		data_bps = nominal_bps;
+	}
+	return (bits_nominal * 1000000ULL) / nominal_bps + (bits_data * 1000000ULL) / data_bps;
+}
+
+/**
+ * @brief Calculate the bus load (RX and TX) over the sliding window, without side effects
+ *
+ * @param mgr                 CAN RX manager device
+ * @param nominal_bitrate_bps Bitrate used for arbitration/CRC/control (bps), 0 for the devicetree value
+ * @param data_bitrate_bps    Bitrate used for FD data phase when BRS is set (bps), 0 for the devicetree value
+ * @return load percentage in range [0.0 .. 100.0], negative on error.
+ */
+static float rp_can_rx_manager_calculate_load(const struct device *mgr, uint32_t nominal_bitrate_bps, uint32_t data_bitrate_bps)
+{
+	if (mgr == NULL) {
+		return -EINVAL;
+	}
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+	struct rp_can_bus_window win;
+
+	if (nominal_bitrate_bps == 0U) {
+		nominal_bitrate_bps = cfg->bitrate;
+		if (data_bitrate_bps == 0U) {
+			data_bitrate_bps = cfg->bitrate_data;
+		}
+	}
+	if (nominal_bitrate_bps == 0U) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&data->bus_lock);
+	rp_can_bus_window_get(data, k_uptime_get(), &win);
+	k_spin_unlock(&data->bus_lock, key);
+
+	uint64_t busy = rp_can_bus_busy_us(win.bits_nominal, win.bits_data, nominal_bitrate_bps,
+					   data_bitrate_bps);
+	float load = (float)busy / ((float)win.window_ms * 10.0f);
+
+	return MIN(load, 100.0f);
+}
+
+/**
+ * @brief Read the bus counters, rates and load of a manager
+ *
+ * @param mgr   CAN RX manager device
+ * @param stats Output statistics
+ * @return int  0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_get_bus_stats(const struct device *mgr, struct can_bus_stats *stats)
+{
+	if ((mgr == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+	struct rp_can_bus_window win;
+
+	k_spinlock_key_t key = k_spin_lock(&data->bus_lock);
+	rp_can_bus_window_get(data, k_uptime_get(), &win);
+	stats->rx = data->bus_total[RP_CAN_BUS_RX];
+	stats->tx = data->bus_total[RP_CAN_BUS_TX];
+	stats->id_overflow = data->bus_id_overflow;
+	k_spin_unlock(&data->bus_lock, key);
+
+	uint64_t busy = rp_can_bus_busy_us(win.bits_nominal, win.bits_data, cfg->bitrate, cfg->bitrate_data);
+
+	stats->window_ms = win.window_ms;
+	stats->rx_fps = (uint32_t)(((uint64_t)win.frames[RP_CAN_BUS_RX] * 1000U) / win.window_ms);
+	stats->tx_fps = (uint32_t)(((uint64_t)win.frames[RP_CAN_BUS_TX] * 1000U) / win.window_ms);
+	stats->busy_us = (uint32_t)busy;
+	stats->load = MIN((float)busy / ((float)win.window_ms * 10.0f), 100.0f);
+	return 0;
+}
+
+/**
+ * @brief Read the per-ID frame rates of a manager
+ *
+ * @param mgr   CAN RX manager device
+ * @param rates Output array
+ * @param max   Capacity of rates
+ * @return int  Number of entries written, negative error code on failure
+ */
+static int rp_can_rx_manager_get_id_rates(const struct device *mgr, struct can_bus_id_rate *rates, size_t max)
+{
+	if ((mgr == NULL) || ((rates == NULL) && (max > 0U))) {
+		return -EINVAL;
+	}
+#if CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS > 0
+	struct rp_can_rx_manager_data *data = mgr->data;
+	struct rp_can_bus_window win;
+	size_t num = 0;
+
+	k_spinlock_key_t key = k_spin_lock(&data->bus_lock);
+	rp_can_bus_window_get(data, k_uptime_get(), &win);
+	for (int i = 0; (i < CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS) && (num < max); i++) {
+		const struct rp_can_bus_id *ent = &data->bus_ids[i];
+		uint32_t frames = 0U;
+
+		if (ent->key == 0U) {
+			continue;
+		}
+		for (int s = 0; s < CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES; s++) {
+			if ((win.valid & BIT(s)) != 0U) {
+				frames += ent->frames[s];
+			}
+		}
+		rates[num].id = ent->key & CAN_EXT_ID_MASK;
+		rates[num].ext = (ent->key & RP_CAN_BUS_KEY_EXT) != 0U;
+		rates[num].tx = (ent->key & RP_CAN_BUS_KEY_TX) != 0U;
+		rates[num].frames = frames;
+		rates[num].rate_hz = (uint32_t)(((uint64_t)frames * 1000U) / win.window_ms);
+		num++;
+	}
+	k_spin_unlock(&data->bus_lock, key);
+	return (int)num;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+/**
+ * @brief Account a frame transmitted on the manager's bus
+ *
+ * @param mgr   CAN RX manager device
+ * @param frame Transmitted frame
+ * @return int  0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_account_tx(const struct device *mgr, const struct can_frame *frame)
+{
+	if ((mgr == NULL) || (frame == NULL)) {
+		return -EINVAL;
+	}
+	rp_can_bus_account(mgr->data, frame, RP_CAN_BUS_TX);
+	return 0;
+}
+
+#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
+/**
+ * @brief Read the RX ring occupancy and counters of a manager
+ *
+ * @param mgr   CAN RX manager device
+ * @param stats Output statistics; the high-water mark restarts after each read
+ * @return int  0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_get_ring_stats(const struct device *mgr, struct can_rx_ring_stats *stats)
+{
+	if ((mgr == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+
+	stats->size = 0U;
+	stats->used = 0U;
+	stats->high_water = 0U;
+	for (int cls = 0; cls < RP_CAN_RX_CLASSES; cls++) {
+		uint32_t ring_size = rp_can_rx_ring_len(cfg, cls);
+		uint32_t head = (uint32_t)atomic_get(&data->ring_head[cls]);
+		uint32_t tail = (uint32_t)atomic_get(&data->ring_tail[cls]);
+
+		stats->size += ring_size;
+		stats->used += (head + ring_size - tail) % ring_size;
+		stats->high_water += (uint32_t)atomic_set(&data->ring_hwm[cls], 0);
+	}
+	stats->queued = (uint32_t)atomic_get(&data->rx_queued);
+	stats->dropped = (uint32_t)atomic_get(&data->rx_dropped);
+	return 0;
+}
+#endif
+
+/**
+ * @brief Read how many frames were overwritten in mailboxes before being consumed
+ *
+ * @param mgr         CAN RX manager device
+ * @param listener_id Mailbox listener ID, or -1 for the total of the manager
+ * @param count       Output counter
+ * @return int        0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_get_coalesced(const struct device *mgr, int listener_id, uint32_t *count)
+{
+	if ((mgr == NULL) || (count == NULL) || (listener_id >= CONFIG_CAN_RX_MANAGER_MAX_LISTENERS)) {
+		return -EINVAL;
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_MAILBOX)
+	struct rp_can_rx_manager_data *data = mgr->data;
+
+	if (listener_id < 0) {
+		*count = (uint32_t)atomic_get(&data->mbox_coalesced);
+		return 0;
+	}
+	int gen = rp_can_rx_read_lock(data);
+	const struct rp_can_rx_listener *lst = &data->tables[gen].listeners[listener_id];
+	int ret = 0;
+
+	if (!lst->used || (lst->mbox < 0)) {
+		ret = -ENOENT;
+	} else {
+		*count = data->mbox[lst->mbox].coalesced;
+	}
+	rp_can_rx_read_unlock(data, gen);
+	return ret;
+#else
+	ARG_UNUSED(listener_id);
+	*count = 0U;
+	return -ENOTSUP;
+#endif
+}
 
-struct rp_can_load_calculate
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+/**
+ * @brief Copy the latency histograms of a manager or of one listener
+ *
+ * @param mgr         CAN RX manager device
+ * @param listener_id Listener ID (handler histogram only), or -1 for the manager stages
+ * @param stats       Output histograms
+ * @return int        0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_get_stats(const struct device *mgr, int listener_id,
+				       struct can_rx_manager_stats *stats)
 {
-	/* cumulative bit counters for load calculation */
-	atomic_t rx_bits_nominal; /* bits counted at nominal (arbitration) rate */
-	atomic_t rx_bits_data;	  /* bits counted at data (BRS) rate for FD data phase */
-	uint64_t last_load_ts_ms; /* timestamp of last load snapshot */
-	uint64_t last_load_bits_nominal;
-	uint64_t last_load_bits_data;
-};
+	if ((mgr == NULL) || (stats == NULL) || (listener_id >= CONFIG_CAN_RX_MANAGER_MAX_LISTENERS)) {
+		return -EINVAL;
+	}
+	struct rp_can_rx_manager_data *data = mgr->data;
 
+	if (listener_id < 0) {
+		k_spinlock_key_t key = k_spin_lock(&data->stats_lock);
+		*stats = data->stats;
+		k_spin_unlock(&data->stats_lock, key);
+		return 0;
+	}
+#if defined(CONFIG_CAN_RX_MANAGER_STATS_PER_LISTENER)
+	int gen = rp_can_rx_read_lock(data);
+	bool used = data->tables[gen].listeners[listener_id].used;
 
-struct rp_can_rx_manager_data {
-	struct rp_can_rx_listener listeners[CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];
-	struct k_thread rx_thread;
-	int hw_filter_id;
-#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
-	atomic_t rx_dropped;
-	atomic_t rx_queued;
-	uint32_t last_reported_drops;
+	rp_can_rx_read_unlock(data, gen);
+	if (!used) {
+		return -ENOENT;
+	}
+	memset(stats, 0, sizeof(*stats));
+	k_spinlock_key_t key = k_spin_lock(&data->stats_lock);
+	stats->handler = data->lst_stats[listener_id];
+	k_spin_unlock(&data->stats_lock, key);
+	return 0;
+#else
+	return -ENOTSUP;
 #endif
-	struct rp_can_load_calculate load_calc;
-	double can_load;
-};
+}
 
-struct rp_can_rx_msg {
-	const struct device *mgr;
-	struct can_frame frame;
-};
+/**
+ * @brief Clear the latency histograms of a manager and its listeners
+ *
+ * @param mgr CAN RX manager device
+ * @return int 0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_reset_stats(const struct device *mgr)
+{
+	if (mgr == NULL) {
+		return -EINVAL;
+	}
+	struct rp_can_rx_manager_data *data = mgr->data;
 
-/* Must use K_MSGQ_DEFINE with sizeof(rp_can_rx_msg), NOT CAN_MSGQ_DEFINE which
- * only allocates sizeof(struct can_frame) per element and would cause overflow. */
-K_MSGQ_DEFINE(rp_can_rx_shared_msgq, sizeof(struct rp_can_rx_msg), CONFIG_CAN_RX_MANAGER_RX_MSGQ_LEN, 4);
-K_THREAD_STACK_DEFINE(rp_can_rx_shared_stack, CONFIG_CAN_RX_MANAGER_RX_STACK_SIZE);
-static struct k_thread rp_can_rx_shared_thread_data;
-static atomic_t rp_can_rx_shared_started = ATOMIC_INIT(0);
+	k_spinlock_key_t key = k_spin_lock(&data->stats_lock);
+	memset(&data->stats, 0, sizeof(data->stats));
+#if defined(CONFIG_CAN_RX_MANAGER_STATS_PER_LISTENER)
+	memset(data->lst_stats, 0, sizeof(data->lst_stats));
+#endif
+	k_spin_unlock(&data->stats_lock, key);
+	return 0;
+}
+#endif
 
-static void rp_can_rx_isr_cb(const struct device *can_dev, struct can_frame *frame, void *user_data)
+#if defined(CONFIG_CAN_RX_MANAGER_CAPTURE)
+/**
+ * @brief Start or stop the frame capture of a manager
+ *
+ * @param mgr     CAN RX manager device
+ * @param running true to clear the ring and start recording, false to stop
+ * @return int    0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_capture_ctrl(const struct device *mgr, bool running)
 {
-	ARG_UNUSED(can_dev);
-
-	const struct device *mgr = (const struct device *)user_data;
-	if ((mgr == NULL) || (frame == NULL)) {
-		LOG_ERR("[can_rx_manager] Invalid ISR callback parameters");
-		return;
+	if (mgr == NULL) {
+		return -EINVAL;
 	}
+	struct rp_can_rx_manager_data *data = mgr->data;
 
-	struct rp_can_rx_msg msg;
-	msg.mgr = mgr;
-	msg.frame = *frame;
-
-	/* Skip RTR frames by default */
-	if ((frame->flags & CAN_FRAME_RTR) != 0U) {
-		return;
+	if (!running) {
+		atomic_set(&data->cap_on, 0);
+		return 0;
 	}
+	atomic_set(&data->cap_on, 0);
+	atomic_set(&data->cap_tail, atomic_get(&data->cap_head));
+	data->cap_frames = 0U;
+	data->cap_dropped = 0U;
+	data->cap_hdr = true;
+	atomic_set(&data->cap_on, 1);
+	return 0;
+}
 
-	int ret = k_msgq_put(&rp_can_rx_shared_msgq, &msg, K_NO_WAIT);
-#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
-	/* update per-manager counters for monitoring */
+/**
+ * @brief Move the pcap file header (once) and whole captured records into a buffer
+ *
+ * @param mgr CAN RX manager device
+ * @param buf Output buffer
+ * @param len Size of @p buf
+ * @return int Bytes written, negative error code on failure
+ */
+static int rp_can_rx_manager_capture_read(const struct device *mgr, uint8_t *buf, size_t len)
+{
+	if ((mgr == NULL) || (buf == NULL)) {
+		return -EINVAL;
+	}
 	struct rp_can_rx_manager_data *data = mgr->data;
-	if (data != NULL) {
-		if (ret == 0) {
-			(void)atomic_inc(&data->rx_queued);
-		} else {
-			(void)atomic_inc(&data->rx_dropped);
-		}
-	}
-#endif
-	/* accumulate bus-bit estimates for load calculation (per-manager counters) */
-	struct rp_can_rx_manager_data *mdata = mgr->data;
-	if (mdata != NULL) {
-		/* estimate bits for this frame: nominal bits and data-phase bits */
-		uint32_t nominal_bits = 0;
-		uint32_t data_bits = 0;
-		/* helper: convert DLC to payload length in bytes */
-		static const uint8_t dlc_to_len_map[16] = {0,1,2,3,4,5,6,7,8,12,16,20,24,32,48,64};
-		uint8_t len = (frame->dlc < 16) ? dlc_to_len_map[frame->dlc] : 0;
-
-		bool is_ext = (frame->flags & CAN_FRAME_IDE) != 0U;
-		bool is_fd = (frame->flags & CAN_FRAME_FDF) != 0U;
-		bool is_brs = (frame->flags & CAN_FRAME_BRS) != 0U;
-
-		if (!is_fd) {
-			/* Classic CAN: approximate baseline overhead
-			 * standard ID: ~47 bits overhead, extended ID: ~67 bits
-			 */
-			nominal_bits = (is_ext ? 67U : 47U) + (uint32_t)len * 8U;
-			data_bits = 0U;
-		} else {
-			/* CAN-FD: arbitration/header transmitted at nominal rate; data phase at data rate when BRS set
-			 * Use conservative estimates: header overhead similar to classic; data CRC ~17/21 bits depending on length
-			 */
-			nominal_bits = (is_ext ? 67U : 47U);
-			/* CRC length heuristic */
-			uint32_t crc_bits = (len <= 16U) ? 17U : 21U;
-			data_bits = (uint32_t)len * 8U + crc_bits;
-			/* If BRS not set, data phase also happens at nominal rate -> fold into nominal_bits */
-			if (!is_brs) {
-				nominal_bits += data_bits;
-				data_bits = 0U;
-			}
+	size_t n = 0;
+
+	if (data->cap_hdr) {
+		const uint32_t file_hdr[6] = {
+			RP_CAN_CAP_MAGIC,
+			2U | (4U << 16),	/* version 2.4, host byte order like the magic */
+			0U,
+			0U,
+			RP_CAN_CAP_FD_MTU,	/* snaplen */
+			RP_CAN_CAP_LINKTYPE,
+		};
+
+		if (len < sizeof(file_hdr)) {
+			return -ENOBUFS;
 		}
+		memcpy(buf, file_hdr, sizeof(file_hdr));
+		n = sizeof(file_hdr);
+		data->cap_hdr = false;
+	}
+
+	uint32_t tail = (uint32_t)atomic_get(&data->cap_tail);
+	uint32_t head = (uint32_t)atomic_get(&data->cap_head);
+	while (tail != head) {
+		uint32_t incl_len;
 
-		(void)atomic_add(&mdata->load_calc.rx_bits_nominal, (int)nominal_bits);
-		(void)atomic_add(&mdata->load_calc.rx_bits_data, (int)data_bits);
+		rp_can_rx_capture_copy_out(data, tail + 8U, &incl_len, sizeof(incl_len));
+		uint32_t size = RP_CAN_CAP_REC_HDR + incl_len;
+		if (len - n < size) {
+			break;
+		}
+		rp_can_rx_capture_copy_out(data, tail, &buf[n], size);
+		n += size;
+		tail += size;
 	}
-	ARG_UNUSED(ret);
+	atomic_set(&data->cap_tail, (atomic_val_t)tail);
+
+	return (int)n;
 }
 
 /**
- * @brief Match a CAN frame against a software filter (standard/extended ID supported)
+ * @brief Read the capture state and counters of a manager
  *
- * @param filter Software filter to match against
- * @param frame  Received CAN frame
- * @return true  Frame matches the filter
- * @return false Frame does not match
+ * @param mgr    CAN RX manager device
+ * @param status Output status
+ * @return int   0 on success, negative error code on failure
  */
-static bool rp_can_rx_match(const struct can_filter *filter, const struct can_frame *frame)
+static int rp_can_rx_manager_capture_status(const struct device *mgr, struct can_rx_capture_status *status)
 {
-	uint32_t frame_id = frame->id;
-	uint32_t filter_id = filter->id;
+	if ((mgr == NULL) || (status == NULL)) {
+		return -EINVAL;
+	}
+	struct rp_can_rx_manager_data *data = mgr->data;
 
-	if (((frame->flags & CAN_FRAME_IDE) != 0U) != ((filter->flags & CAN_FILTER_IDE) != 0U)) {
+	status->running = (atomic_get(&data->cap_on) != 0);
+	status->frames = data->cap_frames;
+	status->dropped = data->cap_dropped;
+	status->pending = (uint32_t)atomic_get(&data->cap_head) - (uint32_t)atomic_get(&data->cap_tail);
+	return 0;
+}
+
+/**
+ * @brief Turn one recorded SocketCAN frame back into a struct can_frame
+ *
+ * @param rec   SocketCAN frame header followed by the captured payload
+ * @param incl  Captured length of @p rec
+ * @param orig  Original length (SocketCAN MTU) of the frame
+ * @param frame Output frame
+ * @return true  @p frame is ready to be injected
+ * @return false Error frame, or not representable in this build
+ */
+static bool rp_can_rx_capture_decode(const uint8_t *rec, uint32_t incl, uint32_t orig, struct can_frame *frame)
+{
+	uint32_t can_id = sys_get_be32(rec);
+	uint8_t len = rec[4];
+	uint8_t fd_flags = rec[5];
+
+	if ((can_id & RP_CAN_CAP_ERR) != 0U) {
 		return false;
 	}
-
-	if ((frame->flags & CAN_FRAME_IDE) != 0U) {
-		frame_id &= CAN_EXT_ID_MASK;
-		filter_id &= CAN_EXT_ID_MASK;
+	memset(frame, 0, sizeof(*frame));
+	if ((can_id & RP_CAN_CAP_EFF) != 0U) {
+		frame->id = can_id & CAN_EXT_ID_MASK;
+		frame->flags |= CAN_FRAME_IDE;
 	} else {
-		frame_id &= CAN_STD_ID_MASK;
-		filter_id &= CAN_STD_ID_MASK;
+		frame->id = can_id & CAN_STD_ID_MASK;
 	}
-	/* Compute masked values and log them for debugging */
-	uint32_t masked_frame = frame_id & filter->mask;
-	uint32_t masked_filter = filter_id & filter->mask;
-	if (masked_frame == masked_filter) {
+	if (((fd_flags & RP_CAN_CAP_FD_FDF) != 0U) || (orig == RP_CAN_CAP_FD_MTU)) {
+		if (!IS_ENABLED(CONFIG_CAN_FD_MODE)) {
+			return false;
+		}
+		frame->flags |= CAN_FRAME_FDF;
+		frame->flags |= ((fd_flags & RP_CAN_CAP_FD_BRS) != 0U) ? CAN_FRAME_BRS : 0U;
+		frame->flags |= ((fd_flags & RP_CAN_CAP_FD_ESI) != 0U) ? CAN_FRAME_ESI : 0U;
+	} else if ((can_id & RP_CAN_CAP_RTR) != 0U) {
+		frame->flags |= CAN_FRAME_RTR;
+		frame->dlc = MIN(len, CAN_MAX_DLC);
 		return true;
-	} else {
+	}
+	if (len > CAN_MAX_DLEN) {
 		return false;
 	}
+	frame->dlc = can_bytes_to_dlc(len);
+	memcpy(frame->data, &rec[RP_CAN_CAP_CAN_HDR], MIN(len, incl - RP_CAN_CAP_CAN_HDR));
+	return true;
 }
 
 /**
- * @brief Shared RX processing thread for all CAN manager instances
+ * @brief Inject a recorded capture stream into a manager
  *
- * @param p1 Unused
- * @param p2 Unused
- * @param p3 Unused
+ * @param mgr       CAN RX manager device
+ * @param trace     pcap stream, file header optional
+ * @param len       Length of @p trace
+ * @param speed_pct Playback speed in percent of the recorded timing, 0 for unpaced
+ * @return int      Frames injected, negative error code on a malformed trace
  */
-static void rp_can_rx_thread(void *p1, void *p2, void *p3)
+static int rp_can_rx_manager_replay(const struct device *mgr, const uint8_t *trace, size_t len,
+				    uint32_t speed_pct)
 {
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
+	if ((mgr == NULL) || (trace == NULL)) {
+		return -EINVAL;
+	}
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+	size_t off = 0;
+	bool ns = false;
 
-	struct rp_can_rx_msg msg;
+	if (len >= CAN_RX_CAPTURE_FILE_HDR) {
+		uint32_t file_hdr[6];
 
-	while (true) {
-		int ret = k_msgq_get(&rp_can_rx_shared_msgq, &msg, K_FOREVER);  /* Block until a CAN frame is available in the queue */
-		if (ret != 0) {
-			continue;
+		memcpy(file_hdr, trace, sizeof(file_hdr));
+		if ((file_hdr[0] == RP_CAN_CAP_MAGIC) || (file_hdr[0] == RP_CAN_CAP_MAGIC_NS)) {
+			if (file_hdr[5] != RP_CAN_CAP_LINKTYPE) {
+				return -ENOTSUP;
+			}
+			ns = (file_hdr[0] == RP_CAN_CAP_MAGIC_NS);
+			off = sizeof(file_hdr);
 		}
+	}
 
-		/* Process this message and try to drain queue to reduce wakeups,
-		 * but limit number processed per wake to avoid unbounded stack/CPU use.
-		 */
-		int batch = 0;
-		for (;;) {
-			struct rp_can_rx_manager_data *data = NULL;
-			if (msg.mgr != NULL) {
-				data = msg.mgr->data;
-			}
-			if (data != NULL) {
-				struct can_frame *frame = &msg.frame;
-				for (int i = 0; i < CONFIG_CAN_RX_MANAGER_MAX_LISTENERS; i++) {		/* Iterate all listener slots; invoke handler if filter matches */
-					struct rp_can_rx_listener *lst = &data->listeners[i];
-					if (!lst->used) {
-						continue;
-					}
-					if (!rp_can_rx_match(&lst->filter, frame)) {
-						continue;
-					}
-					lst->handler(frame, lst->user_data);
-				}
-			}
+	int64_t start_us = rp_can_rx_capture_now_us();
+	int64_t first_ts = 0;
+	int count = 0;
 
-	#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
-			/* Report drops per-manager when threshold reached */
-			if (data != NULL) {
-				uint32_t drops = (uint32_t)atomic_get(&data->rx_dropped);
-				uint32_t last = data->last_reported_drops;
-				if (drops > last) {
-					uint32_t delta = drops - last;
-					if ((uint32_t)CONFIG_CAN_RX_MANAGER_MSGQ_WARN_EVERY_N_DROPS > 0 &&
-					    delta >= (uint32_t)CONFIG_CAN_RX_MANAGER_MSGQ_WARN_EVERY_N_DROPS) {
-						LOG_WRN("can_rx_manager(%p): %u frames dropped (cumulative)", msg.mgr, drops);
-						data->last_reported_drops = drops;
-					}
-				}
-			}
-	#endif
+	while (len - off >= RP_CAN_CAP_REC_HDR) {
+		uint32_t hdr[4];
+		struct can_frame frame;
 
-			batch++;
-			if (batch >= CONFIG_CAN_RX_MANAGER_BATCH_LIMIT) {
-				//LOG_DBG("RX mgr batch limit %d reached, may be busy", (int)CONFIG_CAN_RX_MANAGER_BATCH_LIMIT);
-				k_yield();
-				break;
-			}
+		memcpy(hdr, &trace[off], sizeof(hdr));
+		if ((hdr[2] < RP_CAN_CAP_CAN_HDR) || (hdr[2] > RP_CAN_CAP_FD_MTU) ||
+		    (len - off - RP_CAN_CAP_REC_HDR < hdr[2])) {
+			return -EBADMSG;
+		}
+		const uint8_t *rec = &trace[off + RP_CAN_CAP_REC_HDR];
+		off += RP_CAN_CAP_REC_HDR + hdr[2];
+		if (!rp_can_rx_capture_decode(rec, hdr[2], hdr[3], &frame)) {
+			continue;
+		}
 
-			if (k_msgq_get(&rp_can_rx_shared_msgq, &msg, K_NO_WAIT) != 0) {
-				break; /* no more messages immediately available */
+		int64_t ts = (int64_t)hdr[0] * USEC_PER_SEC + (ns ? (hdr[1] / 1000U) : hdr[1]);
+		if (count == 0) {
+			first_ts = ts;
+		}
+		if (speed_pct > 0U) {
+			/* pace against the start of the replay, so sleep overshoot does not accumulate */
+			int64_t due = start_us + (ts - first_ts) * 100 / (int64_t)speed_pct;
+			int64_t wait = due - rp_can_rx_capture_now_us();
+			if (wait > 0) {
+				k_usleep((int32_t)MIN(wait, (int64_t)INT32_MAX));
+			}
+		} else {
+			uint32_t pos;
+			uint32_t next;
+
+			/* unpaced: never let a ring overflow, the RX threads set the rate */
+			for (int cls = 0; cls < RP_CAN_RX_CLASSES; cls++) {
+				while (!rp_can_rx_ring_room(cfg, data, cls, RP_CAN_RX_REC_SIZE(CAN_MAX_DLEN), &pos,
+							    &next)) {
+					k_sleep(K_TICKS(1));
+				}
 			}
 		}
+
+		const struct can_rx_meta meta = {
+			.rx_cycles = k_cycle_get_32(),
+		};
+		unsigned int key = irq_lock();	/* the ring has a single producer: keep the CAN ISR out */
+		rp_can_rx_ingest(mgr, &frame, &meta);
+		irq_unlock(key);
+		count++;
 	}
+
+	return count;
 }
+#endif /* CONFIG_CAN_RX_MANAGER_CAPTURE */
 
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
 /**
- * @brief Register a software RX listener. All CAN devices must register here before
- *        receiving frames through the manager.
+ * @brief Start (or restart) learning the frame period of a listener
  *
- * @param mgr       CAN RX manager device
- * @param filter    Software filter for frame matching
- * @param handler   Callback invoked when a matching frame is received
- * @param user_data Opaque pointer passed to the handler
- * @return int      Listener ID on success, negative error code on failure
+ * @param mgr         CAN RX manager device
+ * @param listener_id Listener ID
+ * @param timeout_ms  Offline timeout, 0 to derive it from the learned period
+ * @param cb          State change callback, may be NULL
+ * @param user_data   Opaque pointer passed to @p cb
+ * @return int        0 on success, negative error code on failure
  */
-int rp_can_rx_manager_register(const struct device *mgr, const struct can_filter *filter,
-			      can_rx_handler_t handler, void *user_data)
+static int rp_can_rx_manager_watch(const struct device *mgr, int listener_id, uint32_t timeout_ms,
+				   can_rx_liveness_cb_t cb, void *user_data)
 {
-	if ((mgr == NULL) || (filter == NULL) || (handler == NULL)) {
+	if ((mgr == NULL) || (listener_id < 0) || (listener_id >= CONFIG_CAN_RX_MANAGER_MAX_LISTENERS)) {
 		return -EINVAL;
 	}
-	if (!device_is_ready(mgr)) {
-		return -ENODEV;
+	/* ages are differences of the 32-bit cycle counter */
+	uint64_t timeout = k_ms_to_cyc_ceil64(timeout_ms);
+	if (timeout > (uint64_t)INT32_MAX) {
+		return -ERANGE;
 	}
-
 	struct rp_can_rx_manager_data *data = mgr->data;
-	if (data == NULL) {
-		return -EINVAL;
-	}
 
-	for (int i = 0; i < CONFIG_CAN_RX_MANAGER_MAX_LISTENERS; i++) {
-		if (data->listeners[i].used) {
-			continue;
+	k_mutex_lock(&data->reg_lock, K_FOREVER);
+	if (!data->tables[atomic_get(&data->active)].listeners[listener_id].used) {
+		k_mutex_unlock(&data->reg_lock);
+		return -ENOENT;
+	}
+	int idx = data->live_idx[listener_id];
+	for (int i = 0; (idx < 0) && (i < CONFIG_CAN_RX_MANAGER_LIVENESS_NUM); i++) {
+		if (data->live[i].owner < 0) {
+			idx = i;
 		}
-		data->listeners[i].used = true;
-		data->listeners[i].filter = *filter;
-		data->listeners[i].handler = handler;
-		data->listeners[i].user_data = user_data;
-		LOG_INF("can_rx_manager: registered listener id=%d filter_id=0x%03x mask=0x%03x", i, (unsigned int)filter->id, (unsigned int)filter->mask);
-		return i;
+	}
+	if (idx < 0) {
+		k_mutex_unlock(&data->reg_lock);
+		return -ENOSPC;
 	}
 
-	return -ENOSPC;
+	struct rp_can_rx_live *lv = &data->live[idx];
+	k_spinlock_key_t key = k_spin_lock(&data->live_lock);
+	memset(lv, 0, sizeof(*lv));
+	lv->owner = (int16_t)listener_id;
+	lv->state = CAN_RX_LIVE_UNKNOWN;
+	lv->last = k_cycle_get_32();	/* a missing first frame times out from here */
+	lv->min = UINT32_MAX;
+	lv->timeout = (uint32_t)timeout;
+	lv->cb = cb;
+	lv->user_data = user_data;
+	data->live_idx[listener_id] = (int16_t)idx;
+	k_spin_unlock(&data->live_lock, key);
+	k_mutex_unlock(&data->reg_lock);
+
+	/* the new offline deadline may come before the one the timer is armed for */
+	k_timer_start(&data->live_timer, K_NO_WAIT, K_NO_WAIT);
+	return 0;
 }
 
 /**
- * @brief Unregister a previously registered listener
+ * @brief Copy the arrival statistics of a watched listener
  *
  * @param mgr         CAN RX manager device
- * @param listener_id Listener ID returned by rp_can_rx_manager_register()
+ * @param listener_id Listener ID
+ * @param stats       Output statistics
  * @return int        0 on success, negative error code on failure
  */
-int rp_can_rx_manager_unregister(const struct device *mgr, int listener_id)
+static int rp_can_rx_manager_get_liveness(const struct device *mgr, int listener_id,
+					  struct can_rx_liveness_stats *stats)
 {
-	if ((mgr == NULL) || (listener_id < 0) || (listener_id >= CONFIG_CAN_RX_MANAGER_MAX_LISTENERS)) {
+	if ((mgr == NULL) || (stats == NULL) || (listener_id < 0) ||
+	    (listener_id >= CONFIG_CAN_RX_MANAGER_MAX_LISTENERS)) {
 		return -EINVAL;
 	}
-	if (!device_is_ready(mgr)) {
-		return -ENODEV;
-	}
-
 	struct rp_can_rx_manager_data *data = mgr->data;
-	if (data == NULL) {
-		return -EINVAL;
-	}
 
-	if (!data->listeners[listener_id].used) {
+	k_spinlock_key_t key = k_spin_lock(&data->live_lock);
+	int idx = data->live_idx[listener_id];
+	if (idx < 0) {
+		k_spin_unlock(&data->live_lock, key);
 		return -ENOENT;
 	}
-
-	data->listeners[listener_id].used = false;
-	data->listeners[listener_id].handler = NULL;
-	data->listeners[listener_id].user_data = NULL;
-	memset(&data->listeners[listener_id].filter, 0, sizeof(data->listeners[listener_id].filter));
+	const struct rp_can_rx_live *lv = &data->live[idx];
+	bool learned = (lv->learned >= CONFIG_CAN_RX_MANAGER_LIVENESS_LEARN);
+
+	stats->state = (enum can_rx_liveness)lv->state;
+	stats->frames = lv->frames;
+	stats->period_us = learned ? k_cyc_to_us_floor32(lv->period) : 0U;
+	stats->jitter_us = learned ? k_cyc_to_us_floor32(lv->jitter) : 0U;
+	stats->min_us = (lv->min != UINT32_MAX) ? k_cyc_to_us_floor32(lv->min) : 0U;
+	stats->max_us = k_cyc_to_us_floor32(lv->max);
+	stats->age_us = k_cyc_to_us_floor32(k_cycle_get_32() - lv->last);
+	stats->late = lv->late;
+	stats->offline = lv->offline;
+	k_spin_unlock(&data->live_lock, key);
 	return 0;
 }
+#endif /* CONFIG_CAN_RX_MANAGER_LIVENESS */
 
-
+#if defined(CONFIG_CAN_RX_MANAGER_BUS_RECOVERY)
 /**
- * @brief CAN RX manager driver initialization
+ * @brief Copy the controller state history of a manager's bus
  *
- * @param dev Device instance
- * @return int 0 on success, negative error code on failure
+ * @param mgr    CAN RX manager device
+ * @param health Output statistics
+ * @return int   0 on success, negative error code on failure
  */
-static int rp_can_rx_manager_init(const struct device *dev)
+static int rp_can_rx_manager_get_bus_health(const struct device *mgr, struct can_bus_health *health)
 {
-	const struct rp_can_rx_manager_cfg *cfg = dev->config;
-	struct rp_can_rx_manager_data *data = dev->data;
-
-	if ((cfg == NULL) || (data == NULL)) {
-		LOG_ERR("[can_rx_manager] init failed - invalid config or data");
+	if ((mgr == NULL) || (health == NULL)) {
 		return -EINVAL;
 	}
-	if (!device_is_ready(cfg->can_dev)) {
-		LOG_ERR("[can_rx_manager] init failed - CAN device not ready");
-		return -ENODEV;
-	}
-
-	int ret = can_start(cfg->can_dev); // 启动 CAN 设备,
-	if ((ret < 0) && (ret != -EALREADY))
-	{
-		return ret;
-	}
-
-	/* One broad hardware filter: accept all standard IDs into manager msgq */
-	const struct can_filter hw = {
-		.id = 0,
-		.mask = 0,
-		.flags = 0,
-	};
-
-	/* Register a single ISR callback that will enqueue into the shared msgq */
-	ret = can_add_rx_filter(cfg->can_dev, rp_can_rx_isr_cb, (void *)dev, &hw);
-	if (ret < 0) {
-		return ret;
-	}
-	data->hw_filter_id = ret;
-
-	/* Start the shared processing thread once */
-	/* Initialize monitoring counters if enabled */
-#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
-	atomic_set(&data->rx_dropped, 0);
-	atomic_set(&data->rx_queued, 0);
-	data->last_reported_drops = 0;
-#endif
-	/* The shared thread only needs to be started once across all instances; guard with atomic CAS */
-	if (atomic_cas(&rp_can_rx_shared_started, 0, 1)) {
-		k_thread_create(&rp_can_rx_shared_thread_data, rp_can_rx_shared_stack,
-				K_THREAD_STACK_SIZEOF(rp_can_rx_shared_stack), rp_can_rx_thread,
-				NULL, NULL, NULL, CONFIG_CAN_RX_MANAGER_RX_THREAD_PRIO, 0, K_NO_WAIT);
-	}
-
+	const struct rp_can_rx_manager_cfg *cfg = mgr->config;
+	struct rp_can_rx_manager_data *data = mgr->data;
+	struct rp_can_rx_health *h = &data->health;
+	struct can_bus_err_cnt err_cnt;
+	enum can_state state;
+	int ret = can_get_state(cfg->can_dev, &state, &err_cnt);
+
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	enum can_state cur = (enum can_state)atomic_get(&h->state);
+	int64_t open = k_uptime_ticks() - h->since;
+
+	health->state = (ret == 0) ? state : cur;
+	health->err_cnt = (ret == 0) ? err_cnt : h->err_cnt;
+	health->error_passive = h->error_passive;
+	health->bus_off = h->bus_off;
+	health->restarts = h->restarts;
+	health->recoveries = h->recoveries;
+	health->error_passive_us =
+		k_ticks_to_us_floor64((uint64_t)(h->passive_ticks + ((cur == CAN_STATE_ERROR_PASSIVE) ? open : 0)));
+	health->bus_off_us = k_ticks_to_us_floor64((uint64_t)(h->off_ticks + ((cur == CAN_STATE_BUS_OFF) ? open : 0)));
+	health->last_recovery_us = h->last_us;
+	health->max_recovery_us = h->max_us;
+	health->backoff_ms = (cur == CAN_STATE_BUS_OFF) ? h->backoff_ms : 0U;
+	k_spin_unlock(&h->lock, key);
 	return 0;
 }
 
 /**
- * @brief
+ * @brief Controller state as last reported to the manager
  *
- * @param mgr
- * @param nominal_bitrate_bps Bitrate used for arbitration/CRC/control (bps)
- * @param data_bitrate_bps Bitrate used for FD data phase when BRS is set (bps). If 0, FD data is assumed to use nominal rate.
- * @return load percentage in range [0.0 .. 100.0], negative on error.
+ * @param mgr CAN RX manager device
+ * @return int enum can_state, negative error code on failure
  */
-static float rp_can_rx_manager_calculate_load(const struct device *mgr, uint32_t nominal_bitrate_bps, uint32_t data_bitrate_bps)
+static int rp_can_rx_manager_get_bus_state(const struct device *mgr)
 {
 	if (mgr == NULL) {
 		return -EINVAL;
 	}
 	struct rp_can_rx_manager_data *data = mgr->data;
-	if (data == NULL) {
-		return -EINVAL;
-	}
-
-	uint64_t now_ms = k_uptime_get();
-
-	/* Read 32-bit atomic counters (they may wrap); handle wrap-around below */
-	uint32_t cur_nom32 = (uint32_t)atomic_get(&data->load_calc.rx_bits_nominal);
-	uint32_t cur_dat32 = (uint32_t)atomic_get(&data->load_calc.rx_bits_data);
-
-	uint64_t last_nom = data->load_calc.last_load_bits_nominal;
-	uint64_t last_dat = data->load_calc.last_load_bits_data;
-	uint64_t last_ts = data->load_calc.last_load_ts_ms;
 
-	/* On first call initialize snapshots */
-	if (last_ts == 0) {
-		data->load_calc.last_load_bits_nominal = cur_nom32;
-		data->load_calc.last_load_bits_data = cur_dat32;
-		data->load_calc.last_load_ts_ms = now_ms;
-		return 0.0f;
-	}
-
-	/* Compute deltas handling 32-bit wrap-around of the atomic counters.
-	 * `last_nom`/`last_dat` store the previous low-32 snapshot value.
-	 */
-	uint32_t last_nom32 = (uint32_t)(last_nom & 0xFFFFFFFFU);
-	uint32_t last_dat32 = (uint32_t)(last_dat & 0xFFFFFFFFU);
-
-	uint64_t delta_nom;
-	if (cur_nom32 >= last_nom32) {
-		delta_nom = (uint64_t)(cur_nom32 - last_nom32);
-	} else {
-		/* wrapped */
-		delta_nom = (uint64_t)cur_nom32 + (uint64_t)UINT32_MAX + 1ULL - (uint64_t)last_nom32;
-	}
-
-	uint64_t delta_dat;
-	if (cur_dat32 >= last_dat32) {
-		delta_dat = (uint64_t)(cur_dat32 - last_dat32);
-	} else {
-		delta_dat = (uint64_t)cur_dat32 + (uint64_t)UINT32_MAX + 1ULL - (uint64_t)last_dat32;
-	}
-	uint64_t delta_ms = (now_ms > last_ts) ? (now_ms - last_ts) : 0;
-	if (delta_ms == 0) {
-		return 0.0f;
-	}
+	return (int)atomic_get(&data->health.state);
+}
 
-	if (nominal_bitrate_bps == 0) {
+/**
+ * @brief Set the application callback controller state changes are forwarded to
+ *
+ * @param mgr       CAN RX manager device
+ * @param cb        Callback, NULL to remove it
+ * @param user_data Opaque pointer passed to @p cb
+ * @return int      0 on success, negative error code on failure
+ */
+static int rp_can_rx_manager_set_state_cb(const struct device *mgr, can_state_change_callback_t cb,
+					  void *user_data)
+{
+	if (mgr == NULL) {
 		return -EINVAL;
 	}
-	if (data_bitrate_bps == 0) {
-		data_bitrate_bps = nominal_bitrate_bps;
-	}
-
-	/* Time on bus in seconds = bits_at_nominal/nominal_bps + bits_at_data/data_bps */
-	double t_nom = (double)delta_nom / (double)nominal_bitrate_bps;
-	double t_dat = (double)delta_dat / (double)data_bitrate_bps;
-	double elapsed_s = (double)delta_ms / 1000.0;
-
-	double load = 0.0;
-	if (elapsed_s > 0.0) {
-		load = (t_nom + t_dat) / elapsed_s * 100.0;
-		if (load < 0.0) {
-			load = 0.0;
-		} else if (load > 100.0) {
-			load = 100.0;
-		}
-	}
-
-	/* update snapshots (store low-32 snapshots so wrap handling works next call) */
-	data->load_calc.last_load_bits_nominal = (uint64_t)cur_nom32;
-	data->load_calc.last_load_bits_data = (uint64_t)cur_dat32;
-	data->load_calc.last_load_ts_ms = now_ms;
+	struct rp_can_rx_manager_data *data = mgr->data;
 
-	return (float)load;
+	k_spinlock_key_t key = k_spin_lock(&data->health.lock);
+	data->health.cb = cb;
+	data->health.user_data = user_data;
+	k_spin_unlock(&data->health.lock, key);
+	return 0;
 }
+#endif /* CONFIG_CAN_RX_MANAGER_BUS_RECOVERY */
 
 static const struct can_rx_manager_api rp_can_rx_mgr_api = {
 	.register_listener = rp_can_rx_manager_register,
 	.unregister_listener = rp_can_rx_manager_unregister,
 	.calculate_load = rp_can_rx_manager_calculate_load,
+	.get_coalesced = rp_can_rx_manager_get_coalesced,
+	.get_bus_stats = rp_can_rx_manager_get_bus_stats,
+	.get_id_rates = rp_can_rx_manager_get_id_rates,
+	.account_tx = rp_can_rx_manager_account_tx,
+#if defined(CONFIG_CAN_RX_MANAGER_STATS)
+	.get_stats = rp_can_rx_manager_get_stats,
+	.reset_stats = rp_can_rx_manager_reset_stats,
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR)
+	.get_ring_stats = rp_can_rx_manager_get_ring_stats,
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_CAPTURE)
+	.capture_ctrl = rp_can_rx_manager_capture_ctrl,
+	.capture_read = rp_can_rx_manager_capture_read,
+	.capture_status = rp_can_rx_manager_capture_status,
+	.replay = rp_can_rx_manager_replay,
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+	.watch = rp_can_rx_manager_watch,
+	.get_liveness = rp_can_rx_manager_get_liveness,
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_BUS_RECOVERY)
+	.get_bus_health = rp_can_rx_manager_get_bus_health,
+	.get_bus_state = rp_can_rx_manager_get_bus_state,
+	.set_state_cb = rp_can_rx_manager_set_state_cb,
+#endif
 };
 
+/* Per-bus wakeup, stack and thread argument, only emitted for instances with `dedicated-rx-thread` */
+#define RP_CAN_RX_MGR_DEDICATED_DEFINE(inst)                                                    \
+	static struct k_sem rp_can_rx_sem_##inst[RP_CAN_RX_CLASSES];                                \
+	static atomic_t rp_can_rx_idle_##inst[RP_CAN_RX_CLASSES];                                   \
+	static const struct device *const rp_can_rx_devs_##inst[] = {DEVICE_DT_INST_GET(inst)};     \
+	K_THREAD_STACK_ARRAY_DEFINE(rp_can_rx_stack_##inst, RP_CAN_RX_CLASSES,                      \
+				    DT_INST_PROP_OR(inst, rx_stack_size, CONFIG_CAN_RX_MANAGER_RX_STACK_SIZE));
+
+#define RP_CAN_RX_MGR_RING_LEN(inst)                                                            \
+	COND_CODE_1(DT_INST_PROP(inst, dedicated_rx_thread),                                        \
+		    (DT_INST_PROP_OR(inst, rx_msgq_len, CONFIG_CAN_RX_MANAGER_RX_MSGQ_LEN)),          \
+		    (RP_CAN_RX_SHARED_RING_LEN))
+
+/* The filter elements of the controller must fit the per-manager filter storage */
+#define RP_CAN_RX_MGR_MRAM_CHECK(inst)                                                          \
+	BUILD_ASSERT((DT_PROP_BY_IDX_OR(DT_INST_PHANDLE(inst, can_bus), bosch_mram_cfg, 1, 0) <=   \
+		      CONFIG_CAN_MCAN_SD_FILTERS_NBR) &&                                                \
+		     (DT_PROP_BY_IDX_OR(DT_INST_PHANDLE(inst, can_bus), bosch_mram_cfg, 2, 0) <=    \
+		      CONFIG_CAN_MCAN_EX_FILTERS_NBR),                                                  \
+		     "bosch,mram-cfg has more filter elements than CAN_MCAN_SD/EX_FILTERS_NBR");
+
 #define RP_CAN_RX_MGR_DEFINE(inst)                                                              \
+	IF_ENABLED(DT_INST_PROP(inst, dedicated_rx_thread), (RP_CAN_RX_MGR_DEDICATED_DEFINE(inst))) \
+	IF_ENABLED(CONFIG_CAN_RX_MANAGER_HW_FILTER, (RP_CAN_RX_MGR_MRAM_CHECK(inst)))             \
+	static uint32_t rp_can_rx_ring_##inst[RP_CAN_RX_RING_WORDS(RP_CAN_RX_MGR_RING_LEN(inst)) +  \
+					      (RP_CAN_RX_CLASSES - 1) * RP_CAN_RX_CLASS_RING_WORDS];     \
 	static const struct rp_can_rx_manager_cfg rp_can_rx_mgr_cfg_##inst = {                      \
 		.can_dev = DEVICE_DT_GET(DT_INST_PHANDLE(inst, can_bus)),                               \
-		.rx_msgq = &rp_can_rx_shared_msgq,                                                      \
-		.rx_stack = rp_can_rx_shared_stack,                                                     \
-		.rx_stack_size = K_THREAD_STACK_SIZEOF(rp_can_rx_shared_stack),                         \
+		.bitrate = DT_PROP_OR(DT_INST_PHANDLE(inst, can_bus), bitrate, 1000000),                \
+		.bitrate_data = DT_PROP_OR(DT_INST_PHANDLE(inst, can_bus), bitrate_data, 0),            \
+		.ring_buf = rp_can_rx_ring_##inst,                                                      \
+		.ring_size = RP_CAN_RX_RING_WORDS(RP_CAN_RX_MGR_RING_LEN(inst)) * sizeof(uint32_t),      \
+		COND_CODE_1(DT_INST_PROP(inst, dedicated_rx_thread), (                                  \
+		.rx_sem = rp_can_rx_sem_##inst,                                                         \
+		.rx_idle = rp_can_rx_idle_##inst,                                                       \
+		.rx_devs = rp_can_rx_devs_##inst,                                                       \
+		.rx_dev_num = 1,                                                                        \
+		.rx_stack = rp_can_rx_stack_##inst[0],                                                  \
+		.rx_stack_len = sizeof(rp_can_rx_stack_##inst[0]),                                      \
+		.rx_stack_size = K_THREAD_STACK_SIZEOF(rp_can_rx_stack_##inst[0]),                      \
+		.rx_thread_prio = DT_INST_PROP_OR(inst, rx_thread_priority,                             \
+						  CONFIG_CAN_RX_MANAGER_RX_THREAD_PRIO),                \
+		.dedicated_rx_thread = true,                                                            \
+		), (                                                                                    \
+		.rx_sem = rp_can_rx_shared_sem,                                                         \
+		.rx_idle = rp_can_rx_shared_idle,                                                       \
+		.rx_devs = rp_can_rx_shared_devs,                                                       \
+		.rx_dev_num = ARRAY_SIZE(rp_can_rx_shared_devs),                                        \
+		.rx_stack = rp_can_rx_shared_stack[0],                                                  \
+		.rx_stack_len = sizeof(rp_can_rx_shared_stack[0]),                                      \
+		.rx_stack_size = K_THREAD_STACK_SIZEOF(rp_can_rx_shared_stack[0]),                      \
+		.rx_thread_prio = CONFIG_CAN_RX_MANAGER_RX_THREAD_PRIO,                                 \
+		.dedicated_rx_thread = false,                                                           \
+		))                                                                                      \
 	};                                                                                          \
 	static struct rp_can_rx_manager_data rp_can_rx_mgr_data_##inst;                             \
 	DEVICE_DT_INST_DEFINE(inst, rp_can_rx_manager_init, NULL, &rp_can_rx_mgr_data_##inst,       \
@@ -491,3 +3050,20 @@ static const struct can_rx_manager_api rp_can_rx_mgr_api = {
 
 DT_INST_FOREACH_STATUS_OKAY(RP_CAN_RX_MGR_DEFINE)
 
+#define RP_CAN_RX_MGR_PTR(inst) DEVICE_DT_INST_GET(inst),
+
+static const struct device *const rp_can_rx_all_mgrs[] = {
+	DT_INST_FOREACH_STATUS_OKAY(RP_CAN_RX_MGR_PTR)
+};
+
+const struct device *can_rx_manager_get_by_bus(const struct device *can_dev)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(rp_can_rx_all_mgrs); i++) {
+		const struct rp_can_rx_manager_cfg *cfg = rp_can_rx_all_mgrs[i]->config;
+
+		if (cfg->can_dev == can_dev) {
+			return rp_can_rx_all_mgrs[i];
+		}
+	}
+	return NULL;
+}
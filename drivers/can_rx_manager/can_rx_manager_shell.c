@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2025 RobotPilots-SZU
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <string.h>
+
+#include <drivers/can_rx_manager.h>
+
+static int rp_can_rx_shell_get_dev(const struct shell *sh, const char *name, const struct device **dev)
+{
+	*dev = device_get_binding(name);
+	if (*dev == NULL) {
+		shell_error(sh, "device %s not found", name);
+		return -ENODEV;
+	}
+	return 0;
+}
+
+#if defined(CONFIG_CAN_RX_MANAGER_STATS_SHELL)
+/**
+ * @brief Print one histogram as a min/avg/p99/max line in microseconds
+ *
+ * @param sh   Shell instance
+ * @param name Stage or listener label
+ * @param hist Histogram
+ */
+static void rp_can_rx_shell_print_hist(const struct shell *sh, const char *name,
+				       const struct can_rx_latency_hist *hist)
+{
+	if (hist->count == 0U) {
+		shell_print(sh, "  %-10s no samples", name);
+		return;
+	}
+	uint32_t avg = (uint32_t)(hist->sum / hist->count);
+
+	shell_print(sh, "  %-10s n=%-8u min=%-6u avg=%-6u p99=%-6u max=%-6u us", name, hist->count,
+		    k_cyc_to_us_floor32(hist->min), k_cyc_to_us_floor32(avg),
+		    k_cyc_to_us_floor32(can_rx_latency_percentile(hist, 990U)),
+		    k_cyc_to_us_floor32(hist->max));
+}
+
+static int cmd_can_rx_stats_show(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct device *mgr;
+	struct can_rx_manager_stats stats;
+	int ret = rp_can_rx_shell_get_dev(sh, argv[1], &mgr);
+
+	if (ret != 0) {
+		return ret;
+	}
+	ret = can_rx_manager_get_stats(mgr, -1, &stats);
+	if (ret != 0) {
+		shell_error(sh, "failed to read stats of %s: %d", mgr->name, ret);
+		return ret;
+	}
+
+	shell_print(sh, "%s:", mgr->name);
+	rp_can_rx_shell_print_hist(sh, "isr", &stats.isr);
+	rp_can_rx_shell_print_hist(sh, "queue", &stats.queue);
+	rp_can_rx_shell_print_hist(sh, "handler", &stats.handler);
+
+	/* per-listener handler times, silently absent without CAN_RX_MANAGER_STATS_PER_LISTENER */
+	for (int id = 0; id < CONFIG_CAN_RX_MANAGER_MAX_LISTENERS; id++) {
+		char label[16];
+
+		if (can_rx_manager_get_stats(mgr, id, &stats) != 0) {
+			continue;
+		}
+		snprintk(label, sizeof(label), "lst %d", id);
+		rp_can_rx_shell_print_hist(sh, label, &stats.handler);
+	}
+	return 0;
+}
+
+static int cmd_can_rx_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct device *mgr;
+	int ret = rp_can_rx_shell_get_dev(sh, argv[1], &mgr);
+
+	if (ret != 0) {
+		return ret;
+	}
+	ret = can_rx_manager_reset_stats(mgr);
+	if (ret != 0) {
+		shell_error(sh, "failed to reset stats of %s: %d", mgr->name, ret);
+	}
+	return ret;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_can_rx_stats,
+	SHELL_CMD_ARG(show, NULL, "Show RX latency histograms: show <manager>",
+		      cmd_can_rx_stats_show, 2, 0),
+	SHELL_CMD_ARG(reset, NULL, "Clear RX latency histograms: reset <manager>",
+		      cmd_can_rx_stats_reset, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(can_rx_stats, &sub_can_rx_stats, "CAN RX manager latency statistics", NULL);
+#endif /* CONFIG_CAN_RX_MANAGER_STATS_SHELL */
+
+#if defined(CONFIG_CAN_RX_MANAGER_CAPTURE_SHELL)
+/* SocketCAN bits in the captured frames */
+#define RP_CAN_RX_SHELL_EFF    BIT(31)
+#define RP_CAN_RX_SHELL_RTR    BIT(30)
+#define RP_CAN_RX_SHELL_FD_FDF BIT(2)
+
+static int cmd_can_rx_capture_ctrl(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct device *mgr;
+	int ret = rp_can_rx_shell_get_dev(sh, argv[1], &mgr);
+
+	if (ret != 0) {
+		return ret;
+	}
+	ret = (strcmp(argv[0], "start") == 0) ? can_rx_manager_capture_start(mgr) : can_rx_manager_capture_stop(mgr);
+	if (ret != 0) {
+		shell_error(sh, "%s capture of %s failed: %d", argv[0], mgr->name, ret);
+	}
+	return ret;
+}
+
+static int cmd_can_rx_capture_status(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct device *mgr;
+	struct can_rx_capture_status status;
+	int ret = rp_can_rx_shell_get_dev(sh, argv[1], &mgr);
+
+	if (ret != 0) {
+		return ret;
+	}
+	ret = can_rx_manager_capture_status(mgr, &status);
+	if (ret != 0) {
+		shell_error(sh, "failed to read capture status of %s: %d", mgr->name, ret);
+		return ret;
+	}
+	shell_print(sh, "%s: %s frames=%u dropped=%u pending=%u bytes", mgr->name,
+		    status.running ? "running" : "stopped", status.frames, status.dropped, status.pending);
+	return 0;
+}
+
+/**
+ * @brief Print one pcap record as a candump -L log line
+ *
+ * @param sh   Shell instance
+ * @param name Interface name written into the line
+ * @param rec  Record header followed by the SocketCAN frame
+ */
+static void rp_can_rx_shell_print_rec(const struct shell *sh, const char *name, const uint8_t *rec)
+{
+	uint32_t hdr[4];
+	char line[2 * CAN_MAX_DLEN + 24];
+	int n;
+
+	memcpy(hdr, rec, sizeof(hdr));
+	const uint8_t *frame = &rec[sizeof(hdr)];
+	uint32_t can_id = sys_get_be32(frame);
+	uint8_t len = MIN(frame[4], hdr[2] - 8U);
+
+	if ((can_id & RP_CAN_RX_SHELL_EFF) != 0U) {
+		n = snprintk(line, sizeof(line), "%08X#", can_id & CAN_EXT_ID_MASK);
+	} else {
+		n = snprintk(line, sizeof(line), "%03X#", can_id & CAN_STD_ID_MASK);
+	}
+	if ((frame[5] & RP_CAN_RX_SHELL_FD_FDF) != 0U) {
+		n += snprintk(&line[n], sizeof(line) - n, "#%X", frame[5] & 0x3U);	/* FD: BRS/ESI nibble */
+	} else if ((can_id & RP_CAN_RX_SHELL_RTR) != 0U) {
+		n += snprintk(&line[n], sizeof(line) - n, "R");
+		len = 0U;
+	}
+	for (uint8_t i = 0; (i < len) && (n < (int)sizeof(line) - 2); i++) {
+		n += snprintk(&line[n], sizeof(line) - n, "%02X", frame[8 + i]);
+	}
+	shell_print(sh, "(%u.%06u) %s %s", hdr[0], hdr[1], name, line);
+}
+
+static int cmd_can_rx_capture_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct device *mgr;
+	uint8_t buf[4 * CAN_RX_CAPTURE_REC_MAX];
+	int ret = rp_can_rx_shell_get_dev(sh, argv[1], &mgr);
+
+	if (ret != 0) {
+		return ret;
+	}
+	while ((ret = can_rx_manager_capture_read(mgr, buf, sizeof(buf))) > 0) {
+		int off = 0;
+		uint32_t magic;
+
+		memcpy(&magic, buf, sizeof(magic));
+		if ((ret >= CAN_RX_CAPTURE_FILE_HDR) && (magic == 0xA1B2C3D4U)) {
+			off = CAN_RX_CAPTURE_FILE_HDR;	/* first read after start */
+		}
+		while (off < ret) {
+			uint32_t incl_len;
+
+			memcpy(&incl_len, &buf[off + 8], sizeof(incl_len));
+			rp_can_rx_shell_print_rec(sh, mgr->name, &buf[off]);
+			off += 16 + (int)incl_len;
+		}
+	}
+	if (ret < 0) {
+		shell_error(sh, "failed to read capture of %s: %d", mgr->name, ret);
+	}
+	return ret;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_can_rx_capture,
+	SHELL_CMD_ARG(start, NULL, "Clear the capture ring and record: start <manager>",
+		      cmd_can_rx_capture_ctrl, 2, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop recording: stop <manager>",
+		      cmd_can_rx_capture_ctrl, 2, 0),
+	SHELL_CMD_ARG(status, NULL, "Show capture counters: status <manager>",
+		      cmd_can_rx_capture_status, 2, 0),
+	SHELL_CMD_ARG(dump, NULL, "Drain captured frames as candump -L lines: dump <manager>",
+		      cmd_can_rx_capture_dump, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(can_rx_capture, &sub_can_rx_capture, "CAN RX manager frame capture", NULL);
+#endif /* CONFIG_CAN_RX_MANAGER_CAPTURE_SHELL */
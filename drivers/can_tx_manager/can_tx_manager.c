@@ -9,50 +9,184 @@
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/can.h>
+#if defined(CONFIG_CAN_TX_MANAGER_TIMER_COUNTER)
+#include <zephyr/drivers/counter.h>
+#endif
 #include <zephyr/sys/util.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/atomic.h>
 #include <drivers/can_tx_manager.h>
+#include <drivers/can_rx_manager.h>
 
 #include <string.h>
 
 #define LOG_LEVEL 3
 LOG_MODULE_REGISTER(can_tx_manager);
 
-#define CAN_TX_MGR_TICK_MS 1U
+#define CAN_TX_MGR_TICK_US CONFIG_CAN_TX_MANAGER_TICK_US
 
 /* maximum allowed periodic transmission frequency */
-#define CAN_TX_MGR_MAX_FREQ (1000U / CAN_TX_MGR_TICK_MS)
+#define CAN_TX_MGR_MAX_FREQ (USEC_PER_SEC / CAN_TX_MGR_TICK_US)
 
-#define _RP_CAN_TX_MGR_DEV_PTR(inst) DEVICE_DT_INST_GET(inst),
+/* ticks of the schedule simulated for the peak occupancy report, and phase candidates tried */
+#define CAN_TX_MGR_PLAN_HORIZON 1024U
+#define CAN_TX_MGR_PLAN_PHASES  256U
+
+/* reschedule posted to the periodic thread: valid bit, interval in bits 16..30, countdown in 0..15 */
+#define CAN_TX_MGR_RESCHED(iv, cnt) (BIT(31) | ((uint32_t)(iv) << 16) | (uint32_t)(cnt))
+BUILD_ASSERT(USEC_PER_SEC / CAN_TX_MGR_TICK_US < BIT(15), "interval does not fit a posted reschedule");
+
+#if defined(CONFIG_CAN_TX_MANAGER_TIMER_KTIMER)
+BUILD_ASSERT(CAN_TX_MGR_TICK_US * CONFIG_SYS_CLOCK_TICKS_PER_SEC >= USEC_PER_SEC,
+             "CONFIG_CAN_TX_MANAGER_TICK_US is shorter than a kernel tick, use the counter backend");
+/* K_USEC() rounds up: any other tick would silently stretch every period and phase */
+BUILD_ASSERT(((uint64_t)CAN_TX_MGR_TICK_US * CONFIG_SYS_CLOCK_TICKS_PER_SEC) % USEC_PER_SEC == 0U,
+             "CONFIG_CAN_TX_MANAGER_TICK_US is not a whole number of kernel ticks");
+#endif
+
+/* Number of instances without `dedicated-tx-thread`; the shared thread only exists if > 0 */
+#define RP_CAN_TX_MGR_SHARED_USER(inst) +(1 - DT_INST_PROP(inst, dedicated_tx_thread))
+#define RP_CAN_TX_MGR_SHARED_USERS (0 DT_INST_FOREACH_STATUS_OKAY(RP_CAN_TX_MGR_SHARED_USER))
+
+/* Sender slot index type; the all-ones value ends the sender chain of a frame */
+#if CONFIG_MAX_DEVICE_SENDERS < 255
+typedef uint8_t rp_can_tx_sender_t;
+#else
+typedef uint16_t rp_can_tx_sender_t;
+#endif
+#define RP_CAN_TX_SENDER_NONE ((rp_can_tx_sender_t)-1)
+
+/* frame handle: slot in bits 0..7, generation of the slot above, so a stale handle is refused */
+#define CAN_TX_MGR_HANDLE(slot, gen) ((int)((((uint32_t)(gen) & 0x7FFFU) << 8) | (uint32_t)(slot)))
+#define CAN_TX_MGR_HANDLE_SLOT(h)    ((uint32_t)(h) & 0xFFU)
 
 typedef struct rp_can_tx_cfg {
     const struct device *can_dev;
+    uint32_t bitrate;               /* nominal bitrate of the bus, from devicetree */
+    uint32_t bitrate_data;          /* CAN-FD data bitrate, 0 if the bus has none */
 } rp_can_tx_cfg_t;
 
 typedef struct device_sender_cfg {
     uint16_t tx_id;
     uint16_t rx_id;
     bool used;
+    rp_can_tx_sender_t next;                 /* next sender of the same frame */
     void *user_data;
     tx_fillbuffer_cb_t fill_buffer_cb;       /* callback used to fill transmit data */
 } device_sender_cfg_t;
 
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+/* feedback synchronization of one frame, see rp_can_tx_manager_set_sync() */
+struct rp_can_tx_sync {
+    const struct device *mgr;       /* TX manager owning the frame, for the timer */
+    struct k_timer timer;           /* offset after the feedback, or the fallback timeout */
+    struct k_work work;             /* the send itself, on the sync work queue */
+    atomic_t seen;                  /* bit i: feedback rx_ids[i] arrived this cycle */
+    atomic_t fed;                   /* the pending timer expiry was started by complete feedback */
+    atomic_t due;                   /* RP_CAN_TX_SYNC_FED / _TIMEOUT: sends queued to the work */
+    uint32_t all;                   /* seen value of a complete feedback group */
+    uint32_t offset_us;
+    uint32_t timeout_us;            /* 0: no fallback */
+    uint32_t rx_ids[CONFIG_CAN_TX_MANAGER_SYNC_MAX_IDS];
+    int listeners[CONFIG_CAN_TX_MANAGER_SYNC_MAX_IDS];
+    uint8_t rx_num;                 /* 0 while the frame is not synchronized */
+};
+#endif
+
+/*
+ * One managed frame. Slots never move while used, so the periodic thread walks them without
+ * the manager lock. The frame itself is double buffered: a writer fills the copy readers are
+ * not using and publishes it by bumping seq; a reader copies buf[seq & 1] and retries only if
+ * a publication completed meanwhile.
+ */
 typedef struct rp_can_item {
-    struct can_frame frame;
+    atomic_t used;                  /* 1 while the slot holds a frame */
+    atomic_t seq;                   /* publications so far; buf[seq & 1] is the latest frame */
+    struct k_spinlock wlock;        /* serializes writers; readers never take it */
+    struct can_frame buf[2];
+    uint16_t id;                    /* tx_id, for lookups without touching the buffers */
     uint16_t frequency;             /* transmit frequency in Hz; 0 means event‑driven */
-    uint16_t interval;              /* interval in ticks (computed during registration) */
-    uint16_t tick_counter;          /* accumulated ticks until next send */
+    atomic_t resched;               /* CAN_TX_MGR_RESCHED() for the periodic thread to apply, or 0 */
+    uint16_t interval;              /* interval in ticks, owned by the periodic thread once used */
+    uint16_t tick_counter;          /* ticks until next send; its start value is the phase */
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+    uint16_t min_frequency;         /* low priority: lowest rate the governor may go to; 0 = never shed */
+#endif
+    uint16_t bits;                  /* estimated length on the bus, for the schedule plan */
+    uint16_t gen;                   /* bumped on every reuse of the slot, part of the frame handle */
+    rp_can_tx_sender_t senders;     /* first sender of this frame, chained through sender_list */
+    uint8_t cb_num;                 /* senders with a fill callback; 0 if producers write the payload */
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+    struct rp_can_tx_sync sync;     /* sent after the feedback of its motors instead of periodically */
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+    uint32_t max_age;               /* send-on-change: longest gap between sends in ticks, 0 = every period */
+    uint32_t sent_tick;             /* manager tick of the last periodic send */
+    bool sent_valid;                /* sent holds a frame the receivers have seen */
+    struct can_frame sent;          /* last periodically sent frame, compared with the next one */
+#endif
 } rp_can_item_t;
 
+#if CONFIG_CAN_TX_MANAGER_TX_SLOTS > 0
+/* a frame lent out by rp_can_tx_manager_reserve() until its transmission completes */
+struct rp_can_tx_slot {
+    struct can_frame frame;         /* filled in place by the caller, handed to can_send() as is */
+    const struct device *mgr;
+    can_tx_callback_t callback;     /* caller's completion callback */
+    void *user_data;
+};
+#endif
+
 typedef struct rp_can_tx_data
 {
     device_sender_cfg_t sender_list[CONFIG_MAX_DEVICE_SENDERS];
     rp_can_item_t can_items[CONFIG_MAX_CAN_FRAMES];    /* managed CAN frames, statically allocated */
-    struct k_mutex lock;                         /* mutex protecting data */
+    ATOMIC_DEFINE(active, CONFIG_MAX_CAN_FRAMES);      /* used slots, walked by the periodic thread */
+    struct k_mutex lock;                         /* serializes (un)registration and rate changes */
+    struct k_mutex fill_lock[CONFIG_MAX_CAN_FRAMES];   /* per frame: its sender chain vs its fill callbacks */
     uint8_t frame_num;                          /* number of active frames */
+#if defined(CONFIG_CAN_RX_MANAGER)
+    const struct device *rx_mgr;                /* RX manager of the same bus, fed with TX statistics */
+#endif
+    uint16_t plan_frames;                       /* peak periodic frames due in one tick */
+    uint32_t plan_bits;                         /* peak periodic bits due in one tick */
+    uint32_t plan_ticks;                        /* ticks the peak was searched over */
+    atomic_t sent_peak;                         /* most periodic frames sent in one tick since the last read */
+    bool bus_down;                              /* periodic frames paused while the bus is off */
+    uint32_t bus_skipped;                       /* periodic frames not sent during the current outage */
+    uint32_t sent;                              /* periodic frames sent */
+#if CONFIG_CAN_TX_MANAGER_TX_SLOTS > 0
+    struct rp_can_tx_slot slots[CONFIG_CAN_TX_MANAGER_TX_SLOTS];
+    atomic_t slot_busy;                         /* bit i: slots[i] is reserved or in flight */
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+    atomic_t sync_sent;                         /* synchronized frames sent after their feedback */
+    atomic_t sync_timeouts;                     /* synchronized frames sent by the fallback timeout */
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+    uint8_t shed;                               /* governor: low-priority rates divided by 1 << shed */
+    struct k_work plan_work;                    /* re-plans after the governor, off the tick thread */
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+    uint32_t ticks;                             /* scheduler ticks seen, clock of sent_tick */
+    uint32_t unchanged;                         /* periodic sends skipped, payload unchanged */
+#endif
 } rp_can_tx_data_t;
 
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+static void rp_can_tx_plan_work(struct k_work *work);
+#endif
+
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+#define RP_CAN_TX_SYNC_FED     BIT(0)
+#define RP_CAN_TX_SYNC_TIMEOUT BIT(1)
+
+/* can_send() may block on the driver's TX lock: synchronized frames are sent from this queue */
+K_THREAD_STACK_DEFINE(s_tx_sync_stack, CONFIG_CAN_TX_MANAGER_SYNC_STACK_SIZE);
+static struct k_work_q s_tx_sync_wq;
+static atomic_t s_tx_sync_started = ATOMIC_INIT(0);
+#endif
+
 /**
  * @brief Initialize TX manager state and mutex
  *
@@ -73,27 +207,399 @@ int rp_can_tx_manager_init(const struct device *dev)
         return -EINVAL;
     }
 
+    /* keep what the RX manager configured (FD, recovery mode) */
+    can_mode_t mode = can_get_mode(cfg->can_dev) | CAN_MODE_ONE_SHOT;  // 关闭自动重发
+#if defined(CONFIG_CAN_FD_MODE)
+    can_mode_t cap;
+    if ((can_get_capabilities(cfg->can_dev, &cap) == 0) && ((cap & CAN_MODE_FD) != 0U)) {
+        mode |= CAN_MODE_FD;                                           // 允许收发 CAN-FD 帧
+    }
+#endif
     can_stop(cfg->can_dev);
-    can_set_mode(cfg->can_dev, CAN_MODE_NORMAL | CAN_MODE_ONE_SHOT);    // 关闭自动重发
+    can_set_mode(cfg->can_dev, mode);
     can_start(cfg->can_dev);
 
     (void)cfg;
     memset(&data->sender_list, 0, sizeof(data->sender_list));
     memset(&data->can_items, 0, sizeof(data->can_items));
+    memset(data->active, 0, sizeof(data->active));
     data->frame_num = 0;
+    data->plan_frames = 0;
+    data->plan_bits = 0;
+    data->plan_ticks = 0;
+    atomic_set(&data->sent_peak, 0);
+    data->bus_down = false;
+    data->bus_skipped = 0;
+    data->sent = 0;
+#if CONFIG_CAN_TX_MANAGER_TX_SLOTS > 0
+    atomic_set(&data->slot_busy, 0);
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+    atomic_set(&data->sync_sent, 0);
+    atomic_set(&data->sync_timeouts, 0);
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+    data->shed = 0;
+    k_work_init(&data->plan_work, rp_can_tx_plan_work);
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+    /* one queue serves the synchronized frames of every bus */
+    if (atomic_cas(&s_tx_sync_started, 0, 1)) {
+        const struct k_work_queue_config wq_cfg = {.name = "can_tx_sync", .no_yield = true};
+
+        k_work_queue_init(&s_tx_sync_wq);
+        k_work_queue_start(&s_tx_sync_wq, s_tx_sync_stack, K_THREAD_STACK_SIZEOF(s_tx_sync_stack),
+                           CONFIG_CAN_TX_MANAGER_SYNC_THREAD_PRIORITY, &wq_cfg);
+    }
+#endif
     k_mutex_init(&data->lock);                                         /* initialize mutex */
+    /* outside can_items: a reused slot is cleared while the thread may still wait on its lock */
+    for (int f = 0; f < CONFIG_MAX_CAN_FRAMES; f++) {
+        k_mutex_init(&data->fill_lock[f]);
+    }
+#if defined(CONFIG_CAN_RX_MANAGER)
+    /* RX managers initialize earlier (CONFIG_CAN_RX_MANAGER_INIT_PRIORITY) */
+    data->rx_mgr = can_rx_manager_get_by_bus(cfg->can_dev);
+#endif
 
     return 0;
 }
 
+/**
+ * @brief Copy the latest published frame of an item (never blocks)
+ *
+ * @param item  Frame slot
+ * @param frame Output frame
+ */
+static void rp_can_tx_snapshot(const rp_can_item_t *item, struct can_frame *frame)
+{
+    atomic_val_t seq;
+
+    do {
+        seq = atomic_get(&item->seq);
+        *frame = item->buf[seq & 1];
+    } while (atomic_get(&item->seq) != seq);
+}
+
+/**
+ * @brief Publish a complete frame as the latest one of an item
+ *
+ * @param item  Frame slot
+ * @param frame Frame to publish
+ */
+static void rp_can_tx_store(rp_can_item_t *item, const struct can_frame *frame)
+{
+    k_spinlock_key_t key = k_spin_lock(&item->wlock);
+    atomic_val_t seq = atomic_get(&item->seq);
+
+    item->buf[(seq + 1) & 1] = *frame;
+    (void)atomic_inc(&item->seq);
+    k_spin_unlock(&item->wlock, key);
+}
+
+/**
+ * @brief Find the slot of a registered tx_id without taking the manager lock
+ *
+ * @param data  TX manager data
+ * @param tx_id CAN identifier
+ * @return rp_can_item_t* Slot, or NULL if the ID is not registered
+ */
+static rp_can_item_t *rp_can_tx_find(rp_can_tx_data_t *data, uint16_t tx_id)
+{
+    for (int f = 0; f < CONFIG_MAX_CAN_FRAMES; f++) {
+        if (atomic_get(&data->can_items[f].used) && (data->can_items[f].id == tx_id)) {
+            return &data->can_items[f];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Resolve a frame handle without taking the manager lock
+ *
+ * @param data   TX manager data
+ * @param handle Handle returned by rp_can_tx_manager_register()
+ * @return rp_can_item_t* Slot, or NULL if the handle is invalid or its frame was removed
+ */
+static rp_can_item_t *rp_can_tx_from_handle(rp_can_tx_data_t *data, int handle)
+{
+    uint32_t slot = CAN_TX_MGR_HANDLE_SLOT(handle);
+
+    if ((handle < 0) || (slot >= CONFIG_MAX_CAN_FRAMES)) {
+        return NULL;
+    }
+    rp_can_item_t *item = &data->can_items[slot];
+    if (!atomic_get(&item->used) || (CAN_TX_MGR_HANDLE(slot, item->gen) != handle)) {
+        return NULL;
+    }
+    return item;
+}
+
+/**
+ * @brief Read the schedule of an item, including a reschedule not applied yet
+ *
+ * @param item      Frame slot
+ * @param interval  Output interval in ticks, 0 if event-driven
+ * @param countdown Output ticks until the next send
+ */
+static void rp_can_tx_sched_of(const rp_can_item_t *item, uint16_t *interval, uint16_t *countdown)
+{
+    atomic_val_t rs = atomic_get(&item->resched);
+
+    if (rs != 0) {
+        *interval = (uint16_t)((rs >> 16) & 0x7FFF);
+        *countdown = (uint16_t)(rs & 0xFFFF);
+    } else {
+        *interval = item->interval;
+        *countdown = item->tick_counter;
+    }
+}
+
+/**
+ * @brief Convert a frequency into a period in scheduler ticks
+ *
+ * @param frequency Frequency in Hz, 0 for event-driven
+ * @return uint16_t Interval in ticks, 0 for event-driven
+ */
+static uint16_t rp_can_tx_interval(uint16_t frequency)
+{
+    if (frequency == 0) {
+        return 0;
+    }
+    uint32_t interval = DIV_ROUND_CLOSEST(USEC_PER_SEC / frequency, CAN_TX_MGR_TICK_US);
+    return (uint16_t)MAX(interval, 1U);
+}
+
+/**
+ * @brief Warn when a requested frequency is not a whole number of ticks
+ *
+ * @param tx_id     CAN identifier, for the log line
+ * @param frequency Requested frequency in Hz
+ */
+static void rp_can_tx_check_rounding(uint16_t tx_id, uint16_t frequency)
+{
+    uint16_t interval = rp_can_tx_interval(frequency);
+
+    if ((frequency != 0) && (interval * CAN_TX_MGR_TICK_US != USEC_PER_SEC / frequency)) {
+        LOG_WRN("[can_tx_manager]tx_id 0x%03x: %d Hz rounded to a %u us period (tick %u us)",
+                tx_id, frequency, interval * CAN_TX_MGR_TICK_US, CAN_TX_MGR_TICK_US);
+    }
+}
+
+/**
+ * @brief Bus length of a frame in nominal bit times
+ *
+ * Same accounting as the bus statistics of the RX manager; the data phase of a BRS frame is
+ * converted to nominal bit times.
+ *
+ * @param cfg   TX manager configuration (bitrates)
+ * @param frame Frame as registered
+ * @return uint16_t Bits
+ */
+static uint16_t rp_can_tx_frame_bits(const rp_can_tx_cfg_t *cfg, const struct can_frame *frame)
+{
+    uint32_t nominal;
+    uint32_t data_phase;
+
+    can_rx_manager_frame_bits(frame, &nominal, &data_phase);
+    if ((data_phase != 0U) && (cfg->bitrate_data != 0U)) {
+        data_phase = (uint32_t)DIV_ROUND_UP((uint64_t)data_phase * cfg->bitrate, cfg->bitrate_data);
+    }
+    return (uint16_t)MIN(nominal + data_phase, UINT16_MAX);
+}
+
+static uint32_t rp_can_tx_gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0U) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief Pick the tick a new periodic item first fires on
+ *
+ * Two periodic items with intervals a and b and countdowns ca and cb meet on some tick iff
+ * ca and cb are congruent modulo gcd(a, b). The phase chosen is the one colliding with the
+ * fewest bits of the existing items, so frames of the same period spread over their cycle
+ * instead of all firing on the same tick. The periodic thread keeps counting down meanwhile,
+ * so a countdown read here may be one tick stale.
+ *
+ * @param data     TX manager data, lock held
+ * @param self     Item being (re)scheduled, left out of the cost
+ * @param interval Interval of the item in ticks
+ * @return uint16_t Initial countdown of the item
+ */
+static uint16_t rp_can_tx_pick_phase(const rp_can_tx_data_t *data, const rp_can_item_t *self,
+                                     uint16_t interval)
+{
+#if defined(CONFIG_CAN_TX_MANAGER_PHASE_STAGGER)
+    uint32_t best_cost = UINT32_MAX;
+    uint16_t best = 0;
+    uint32_t phases = MIN((uint32_t)interval, CAN_TX_MGR_PLAN_PHASES);
+
+    for (uint32_t p = 0; (p < phases) && (best_cost != 0U); p++) {
+        uint32_t cost = 0;
+        for (int f = 0; f < CONFIG_MAX_CAN_FRAMES; f++) {
+            const rp_can_item_t *it = &data->can_items[f];
+            uint16_t iv;
+            uint16_t cnt;
+            if ((it == self) || !atomic_get(&it->used)) {
+                continue;
+            }
+            rp_can_tx_sched_of(it, &iv, &cnt);
+            if (iv == 0) {
+                continue;
+            }
+            uint32_t g = rp_can_tx_gcd(interval, iv);
+            if ((p % g) == (cnt % g)) {
+                cost += it->bits;
+            }
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = (uint16_t)p;
+        }
+    }
+    return best;
+#else
+    ARG_UNUSED(data);
+    ARG_UNUSED(self);
+    return interval - 1U;       /* every item fires on the same tick */
+#endif
+}
+
+/**
+ * @brief Recompute the peak per-tick load of the periodic schedule
+ *
+ * Walks one hyperperiod of the current countdowns, at most CAN_TX_MGR_PLAN_HORIZON ticks.
+ *
+ * @param data TX manager data, lock held
+ */
+static void rp_can_tx_plan(rp_can_tx_data_t *data)
+{
+    uint32_t span = 1;
+    uint16_t peak_frames = 0;
+    uint32_t peak_bits = 0;
+
+    for (int f = 0; f < CONFIG_MAX_CAN_FRAMES; f++) {
+        uint16_t iv;
+        uint16_t cnt;
+        if (!atomic_get(&data->can_items[f].used) || (span >= CAN_TX_MGR_PLAN_HORIZON)) {
+            continue;
+        }
+        rp_can_tx_sched_of(&data->can_items[f], &iv, &cnt);
+        if (iv == 0) {
+            continue;
+        }
+        span = MIN(span / rp_can_tx_gcd(span, iv) * iv, CAN_TX_MGR_PLAN_HORIZON);
+    }
+    for (uint32_t t = 0; t < span; t++) {
+        uint16_t frames = 0;
+        uint32_t bits = 0;
+        for (int f = 0; f < CONFIG_MAX_CAN_FRAMES; f++) {
+            const rp_can_item_t *it = &data->can_items[f];
+            uint16_t iv;
+            uint16_t cnt;
+            if (!atomic_get(&it->used)) {
+                continue;
+            }
+            rp_can_tx_sched_of(it, &iv, &cnt);
+            if ((iv != 0) && ((t % iv) == (cnt % iv))) {
+                frames++;
+                bits += it->bits;
+            }
+        }
+        peak_frames = MAX(peak_frames, frames);
+        peak_bits = MAX(peak_bits, bits);
+    }
+    data->plan_frames = peak_frames;
+    data->plan_bits = peak_bits;
+    data->plan_ticks = span;
+}
+
+/**
+ * @brief Rate an item is scheduled at: its own, or what the governor leaves of it
+ *
+ * @param data TX manager data, lock held
+ * @param item Frame slot
+ * @return uint16_t Frequency in Hz
+ */
+static uint16_t rp_can_tx_rate(const rp_can_tx_data_t *data, const rp_can_item_t *item)
+{
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+    if (item->sync.rx_num != 0) {
+        return 0;               /* its feedback paces it, not the periodic thread */
+    }
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+    if ((item->min_frequency != 0) && (item->frequency > item->min_frequency)) {
+        return MAX(item->frequency >> data->shed, item->min_frequency);
+    }
+#else
+    ARG_UNUSED(data);
+#endif
+    return item->frequency;
+}
+
+/**
+ * @brief Move a registered item to a new rate
+ *
+ * The new interval and phase are posted to the periodic thread, which applies both on its
+ * next tick, so the item never runs with one half of the old schedule and one of the new.
+ * Call rp_can_tx_plan() afterwards.
+ *
+ * @param data      TX manager data, lock held
+ * @param item      Frame slot
+ * @param frequency New rate in Hz, 0 for event-driven
+ */
+static void rp_can_tx_reschedule(rp_can_tx_data_t *data, rp_can_item_t *item, uint16_t frequency)
+{
+    uint16_t interval = rp_can_tx_interval(frequency);
+    uint16_t countdown = (interval > 0) ? rp_can_tx_pick_phase(data, item, interval) : 0;
+
+    atomic_set(&item->resched, CAN_TX_MGR_RESCHED(interval, countdown));
+}
+
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+/**
+ * @brief End the feedback synchronization of a frame
+ *
+ * Removes the feedback listeners, stops the timer and waits for a send in progress; the
+ * frame is left event-driven. Thread context only.
+ *
+ * @param data TX manager data, lock held
+ * @param item Frame slot
+ */
+static void rp_can_tx_sync_stop(rp_can_tx_data_t *data, rp_can_item_t *item)
+{
+    struct rp_can_tx_sync *sync = &item->sync;
+
+    if (sync->rx_num == 0) {
+        return;
+    }
+    for (int i = 0; i < sync->rx_num; i++) {
+        (void)can_rx_manager_unregister(data->rx_mgr, sync->listeners[i]);
+    }
+    sync->rx_num = 0;
+    k_timer_stop(&sync->timer);
+
+    struct k_work_sync done;
+    (void)k_work_cancel_sync(&sync->work, &done);
+}
+#endif
+
 /**
  * @brief Register a transmitter with the TX manager
  *
  * A caller provides an ID, DLC/flags, optional frequency, and a
  * callback to fill the frame before each transmission.  Multiple
  * transmitters may share the same tx_id; they are de-duplicated in the
- * manager and their callbacks will all be invoked when the frame is
- * prepared.
+ * manager, chained to the frame, and their callbacks will all be invoked
+ * when the frame is prepared.  Without any callback the payload is
+ * whatever producers last wrote with rp_can_tx_manager_write().
  *
  * @param mgr Pointer to the CAN TX manager device
  * @param tx_id CAN identifier for outgoing frames
@@ -101,9 +607,10 @@ int rp_can_tx_manager_init(const struct device *dev)
  * @param dlc Data length code for the frame (usually 8)
  * @param flags CAN frame flags (0 for standard frame)
  * @param frequency Transmit rate in Hz (0 means event-driven)
- * @param fill_buffer_cb Callback invoked to populate the frame payload
+ * @param fill_buffer_cb Callback invoked to populate the frame payload, may be NULL
  * @param user_data Opaque pointer passed to the callback
- * @return non‑negative registration index on success, negative error code
+ * @return non‑negative frame handle on success (the same for every sender of tx_id),
+ *         negative error code
  */
 int rp_can_tx_manager_register(const struct device *mgr, uint16_t tx_id, uint16_t rx_id,
                                 uint8_t dlc, uint8_t flags, uint16_t frequency,
@@ -131,55 +638,94 @@ int rp_can_tx_manager_register(const struct device *mgr, uint16_t tx_id, uint16_
     k_mutex_lock(&data->lock, K_FOREVER);
 
     /* check whether the same tx_id is already registered */
-    bool found = false;
-    for (int f = 0; f < data->frame_num; f++) {
-        if (data->can_items[f].frame.id == tx_id) {
-            if (data->can_items[f].frequency != frequency) {
-                LOG_ERR("[can_tx_manager]Cannot register same tx_id 0x%03x with different frequency (existing %d Hz, new %d Hz)", tx_id, data->can_items[f].frequency, frequency);
-                k_mutex_unlock(&data->lock);
-                return -EINVAL;
-            }
-            found = true;
-            break;
-        }
+    rp_can_item_t *item = rp_can_tx_find(data, tx_id);
+    if ((item != NULL) && (item->frequency != frequency)) {
+        LOG_ERR("[can_tx_manager]Cannot register same tx_id 0x%03x with different frequency (existing %d Hz, new %d Hz)", tx_id, item->frequency, frequency);
+        k_mutex_unlock(&data->lock);
+        return -EINVAL;
     }
 
-    if (!found) {
-        if (data->frame_num >= CONFIG_MAX_CAN_FRAMES) {
-            LOG_ERR("[can_tx_manager]No space left for CAN frames");
-            k_mutex_unlock(&data->lock);
-            return -ENOSPC;
-        }
-        memset(&data->can_items[data->frame_num], 0, sizeof(rp_can_item_t));
-        data->can_items[data->frame_num].frame.id = tx_id;
-        data->can_items[data->frame_num].frame.dlc = dlc;
-        data->can_items[data->frame_num].frame.flags = flags;
-        data->can_items[data->frame_num].frequency = frequency;
-        if (frequency > 0) {
-            uint32_t ms_per_cycle = 1000U / frequency;
-            data->can_items[data->frame_num].interval = (uint16_t)DIV_ROUND_UP(ms_per_cycle, CAN_TX_MGR_TICK_MS);
-        }
-        else {
-            data->can_items[data->frame_num].interval = 0;
-        }
-        data->frame_num++;
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+    /* synchronized frames are sent from interrupt context, where fill callbacks cannot run */
+    if ((item != NULL) && (item->sync.rx_num != 0) && (fill_buffer_cb != NULL)) {
+        LOG_ERR("[can_tx_manager]tx_id 0x%03x is feedback synchronized, register without a fill callback", tx_id);
+        k_mutex_unlock(&data->lock);
+        return -ENOTSUP;
     }
-    for (int i = 0; i < CONFIG_MAX_DEVICE_SENDERS; i++) {
-        if (data->sender_list[i].used) {
-            continue;
+#endif
+    /* take the sender slot first, so a full sender table never leaves an orphan frame */
+    int s = 0;
+    while ((s < CONFIG_MAX_DEVICE_SENDERS) && data->sender_list[s].used) {
+        s++;
+    }
+    if (s == CONFIG_MAX_DEVICE_SENDERS) {
+        LOG_ERR("[can_tx_manager]No space left for senders");
+        k_mutex_unlock(&data->lock);
+        return -ENOSPC;
+    }
+
+    bool fresh = (item == NULL);
+    for (int f = 0; (item == NULL) && (f < CONFIG_MAX_CAN_FRAMES); f++) {
+        if (!atomic_get(&data->can_items[f].used)) {
+            item = &data->can_items[f];
         }
-        data->sender_list[i].used = true;
-        data->sender_list[i].tx_id = tx_id;
-        data->sender_list[i].rx_id = rx_id;
-        data->sender_list[i].user_data = user_data;
-        data->sender_list[i].fill_buffer_cb = fill_buffer_cb;
+    }
+    if (item == NULL) {
+        LOG_ERR("[can_tx_manager]No space left for CAN frames");
         k_mutex_unlock(&data->lock);
-        return i; /* return allocated index */
+        return -ENOSPC;
+    }
+    /* the chain of the frame changes: wait for fill callbacks still walking it */
+    struct k_mutex *fill_lock = &data->fill_lock[item - data->can_items];
+    k_mutex_lock(fill_lock, K_FOREVER);
+
+    if (fresh) {
+        /* the slot is free: the periodic thread and the producers do not look at it */
+        uint16_t gen = item->gen + 1U;
+        memset(item, 0, sizeof(rp_can_item_t));
+        item->gen = gen;
+        item->senders = RP_CAN_TX_SENDER_NONE;
+        item->buf[0].id = tx_id;
+        item->buf[0].dlc = dlc;
+        item->buf[0].flags = flags;
+        item->buf[1] = item->buf[0];
+        item->id = tx_id;
+        item->frequency = frequency;
+        /* the thread skips unused slots, so the schedule is set directly */
+        rp_can_tx_check_rounding(tx_id, frequency);
+        item->interval = rp_can_tx_interval(frequency);
+        if (item->interval > 0) {
+            item->tick_counter = rp_can_tx_pick_phase(data, item, item->interval);
+        }
+        item->bits = rp_can_tx_frame_bits((const rp_can_tx_cfg_t *)mgr->config, &item->buf[0]);
+        atomic_set(&item->used, 1);
+        atomic_set_bit(data->active, (int)(item - data->can_items));
+        data->frame_num++;
     }
 
-    /* no free slot available */
+    device_sender_cfg_t *sender = &data->sender_list[s];
+    sender->used = true;
+    sender->tx_id = tx_id;
+    sender->rx_id = rx_id;
+    sender->user_data = user_data;
+    sender->fill_buffer_cb = fill_buffer_cb;
+    /* append, so callbacks keep running in registration order */
+    rp_can_tx_sender_t *link = &item->senders;
+    while (*link != RP_CAN_TX_SENDER_NONE) {
+        link = &data->sender_list[*link].next;
+    }
+    sender->next = RP_CAN_TX_SENDER_NONE;
+    *link = (rp_can_tx_sender_t)s;
+    if (fill_buffer_cb != NULL) {
+        item->cb_num++;
+    }
+    int handle = CAN_TX_MGR_HANDLE(item - data->can_items, item->gen);
+    k_mutex_unlock(fill_lock);
+    if (fresh) {
+        rp_can_tx_plan(data);
+    }
     k_mutex_unlock(&data->lock);
-    return -ENOSPC;
+    return handle;
 }
 
 /**
@@ -210,98 +756,124 @@ int rp_can_tx_manager_unregister(const struct device *mgr, const uint16_t tx_id,
 
     k_mutex_lock(&data->lock, K_FOREVER);
 
-    /* 1. unregister sender with given tx_id */
-    bool found_sender = false;
-    for (int i = 0; i < CONFIG_MAX_DEVICE_SENDERS; i++) {
-        if (!data->sender_list[i].used) {
-            continue;
-        }
-        if (data->sender_list[i].tx_id == tx_id && data->sender_list[i].rx_id == rx_id) {
-            data->sender_list[i].used = false;
-            data->sender_list[i].tx_id = 0;
-            data->sender_list[i].rx_id = 0;
-            data->sender_list[i].user_data = NULL;
-            data->sender_list[i].fill_buffer_cb = NULL;
-            found_sender = true;
-            break;
-        }
+    /* 1. unlink the sender from the chain of its frame */
+    rp_can_item_t *item = rp_can_tx_find(data, tx_id);
+    rp_can_tx_sender_t *link = (item != NULL) ? &item->senders : NULL;
+    while ((link != NULL) && (*link != RP_CAN_TX_SENDER_NONE) &&
+           (data->sender_list[*link].rx_id != rx_id)) {
+        link = &data->sender_list[*link].next;
     }
-
-    if (!found_sender) {
+    if ((link == NULL) || (*link == RP_CAN_TX_SENDER_NONE)) {
         k_mutex_unlock(&data->lock);
         return -ENOENT;
     }
-
-    /* 2. check if other active senders exist for this tx_id */
-    bool other_senders_exist = false;
-    for (int i = 0; i < CONFIG_MAX_DEVICE_SENDERS; i++) {
-        if (data->sender_list[i].used && data->sender_list[i].tx_id == tx_id) {
-            other_senders_exist = true;
-            break;
-        }
+    struct k_mutex *fill_lock = &data->fill_lock[item - data->can_items];
+    k_mutex_lock(fill_lock, K_FOREVER);
+    device_sender_cfg_t *sender = &data->sender_list[*link];
+    *link = sender->next;
+    if (sender->fill_buffer_cb != NULL) {
+        item->cb_num--;
     }
+    memset(sender, 0, sizeof(*sender));
 
-    /* 3. if no other senders exist, delete the associated CAN frame */
-    if (!other_senders_exist) {
-        for (int f = 0; f < data->frame_num; f++) {
-            if (data->can_items[f].frame.id == tx_id) {
-                /* remove the entry by shifting the tail down; memmove would
-                 * express this intent more clearly. */
-                if (f < data->frame_num - 1) {
-                    memmove(&data->can_items[f], &data->can_items[f + 1],
-                            (data->frame_num - f - 1) * sizeof(rp_can_item_t));
-                }
-                data->frame_num--;
-                LOG_INF("[can_tx_manager]CAN frame tx_id 0x%03x deleted (no more senders)", tx_id);
-                break;
-            }
-        }
+    /* 2. if no other senders exist, delete the associated CAN frame */
+    bool deleted = (item->senders == RP_CAN_TX_SENDER_NONE);
+    if (deleted) {
+        /* free the slot in place; the other slots keep their position and phase */
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+        rp_can_tx_sync_stop(data, item);
+#endif
+        atomic_clear_bit(data->active, (int)(item - data->can_items));
+        atomic_set(&item->used, 0);
+        data->frame_num--;
+        LOG_INF("[can_tx_manager]CAN frame tx_id 0x%03x deleted (no more senders)", tx_id);
     }
 
+    k_mutex_unlock(fill_lock);
+    if (deleted) {
+        rp_can_tx_plan(data);
+    }
     k_mutex_unlock(&data->lock);
     return 0; /* successfully unregistered */
 
 }
 
+/**
+ * @brief Report a frame handed to the CAN driver to the bus statistics of the RX manager
+ *
+ * Frames are counted when queued: in one-shot mode every queued frame is put on the bus once.
+ *
+ * @param data TX manager data
+ * @param frame Frame accepted by can_send()
+ */
+static inline void rp_can_tx_account(rp_can_tx_data_t *data, const struct can_frame *frame)
+{
+#if defined(CONFIG_CAN_RX_MANAGER)
+    if (data->rx_mgr != NULL) {
+        (void)can_rx_manager_account_tx(data->rx_mgr, frame);
+    }
+#else
+    ARG_UNUSED(data);
+    ARG_UNUSED(frame);
+#endif
+}
+
+/**
+ * @brief Check whether the bus of a TX manager can take frames
+ *
+ * Asks the RX manager of the same bus, which tracks the controller state and restarts the
+ * controller after bus-off. Without one the bus counts as up and can_send() reports outages.
+ *
+ * @param data TX manager data
+ * @return true unless the controller is bus-off
+ */
+static inline bool rp_can_tx_bus_up(const rp_can_tx_data_t *data)
+{
+#if defined(CONFIG_CAN_RX_MANAGER)
+    if (data->rx_mgr != NULL) {
+        return can_rx_manager_get_bus_state(data->rx_mgr) != CAN_STATE_BUS_OFF;
+    }
+#else
+    ARG_UNUSED(data);
+#endif
+    return true;
+}
+
 /**
  * @brief Invoke registered callbacks to populate CAN transmit buffer for use by send routines
  *
- * @param tx_id
+ * Only the senders chained to the frame are visited.
+ *
+ * @param item
  * @param frame
  * @param data
- * @param user_data
  * @return int
  */
-static int rp_can_tx_fillbuffer(uint16_t tx_id, struct can_frame *frame, rp_can_tx_data_t *data)
+static int rp_can_tx_fillbuffer(const rp_can_item_t *item, struct can_frame *frame, rp_can_tx_data_t *data)
 {
     if (frame == NULL || data == NULL) {
         LOG_ERR("[can_tx_manager]Invalid frame or data pointer");
         return -EINVAL;
     }
 
-    /* call every matching registration callback in turn */
+    /* call every registration callback of the frame in turn */
     int cb_count = 0;
-    for (int i = 0; i < CONFIG_MAX_DEVICE_SENDERS; i++) {
-        if (!data->sender_list[i].used) {
-            continue;
-        }
-        if (data->sender_list[i].tx_id != tx_id) {
-            continue;
-        }
-        if (data->sender_list[i].fill_buffer_cb == NULL) {
+    for (rp_can_tx_sender_t i = item->senders; i != RP_CAN_TX_SENDER_NONE; i = data->sender_list[i].next) {
+        const device_sender_cfg_t *sender = &data->sender_list[i];
+        if (sender->fill_buffer_cb == NULL) {
             continue;
         }
         cb_count++;
-        int ret = data->sender_list[i].fill_buffer_cb(frame, data->sender_list[i].user_data);
+        int ret = sender->fill_buffer_cb(frame, sender->user_data);
         if (ret != 0) {
-            LOG_ERR("[can_tx_manager]Fill buffer callback failed for tx_id 0x%03x, err %d", tx_id, ret);
+            LOG_ERR("[can_tx_manager]Fill buffer callback failed for tx_id 0x%03x, err %d", item->id, ret);
             return ret;
         }
     }
 
     if (cb_count == 0)
     {
-        LOG_ERR("[can_tx_manager]No fill buffer callback for tx_id 0x%03x", tx_id);
+        LOG_ERR("[can_tx_manager]No fill buffer callback for tx_id 0x%03x", item->id);
         return -EINVAL;
     }
 
@@ -309,73 +881,446 @@ static int rp_can_tx_fillbuffer(uint16_t tx_id, struct can_frame *frame, rp_can_
 }
 
 /**
- * @brief Send a CAN frame through the TX manager
+ * @brief Build the next frame of an item from the latest one and its fill callbacks
  *
- * @param mgr CAN TX manager device
- * @param timeout send timeout
- * @param callback completion callback
- * @param tx_filter_id transmit ID (returned by register)
- * @param user_data user data for callback
- * @return int
+ * The callbacks edit the latest published frame, like they edited the stored frame before,
+ * and the result is published for the next send. Call with the fill lock of the item held:
+ * the callbacks are looked up in its sender chain.
+ *
+ * @param data  TX manager data
+ * @param item  Frame slot with cb_num > 0
+ * @param frame Output frame
+ * @return int 0 on success, error of the failing callback otherwise
  */
-int rp_can_tx_manager_send(const struct device *mgr, k_timeout_t timeout, can_tx_callback_t callback, uint16_t tx_id, void *user_data)
+static int rp_can_tx_refill(rp_can_tx_data_t *data, rp_can_item_t *item, struct can_frame *frame)
 {
-    if (mgr == NULL) {
-        LOG_ERR("[can_tx_manager]CAN TX manager device is NULL");
-        return -EINVAL;
+    rp_can_tx_snapshot(item, frame);
+    int ret = rp_can_tx_fillbuffer(item, frame, data);
+    if (ret == 0) {
+        rp_can_tx_store(item, frame);
     }
+    return ret;
+}
 
-    const rp_can_tx_cfg_t *cfg = (const rp_can_tx_cfg_t *)mgr->config;
-    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
-    if (cfg == NULL || cfg->can_dev == NULL || data == NULL) {
-        LOG_ERR("[can_tx_manager]Invalid CAN TX manager configuration");
-        return -ENODEV;
+/**
+ * @brief Take the frame an item sends next
+ *
+ * Frames written by producers are copied without any lock; items with legacy fill callbacks
+ * take only their own fill lock while the callbacks run, so (un)registration of other frames
+ * and rate changes never hold up the periodic thread.
+ *
+ * @param data  TX manager data
+ * @param item  Frame slot
+ * @param frame Output frame
+ * @return int 0 on success, negative error code on failure
+ */
+static int rp_can_tx_take(rp_can_tx_data_t *data, rp_can_item_t *item, struct can_frame *frame)
+{
+    if (item->cb_num == 0) {
+        rp_can_tx_snapshot(item, frame);
+        return 0;
     }
+    struct k_mutex *fill_lock = &data->fill_lock[item - data->can_items];
 
-    k_mutex_lock(&data->lock, K_FOREVER);
+    k_mutex_lock(fill_lock, K_FOREVER);
+    int ret = atomic_get(&item->used) ? rp_can_tx_refill(data, item, frame) : -ENOENT;
+    k_mutex_unlock(fill_lock);
+    return ret;
+}
 
-    if(data->frame_num == 0) {
-        LOG_ERR("[can_tx_manager]No CAN frames registered for transmission");
-        k_mutex_unlock(&data->lock);
+/**
+ * @brief Change the rate of a registered frame at runtime
+ *
+ * The frame gets a new phase chosen like at registration; the periodic thread switches to the
+ * new interval and phase together on its next tick.
+ *
+ * @param mgr CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame
+ * @param frequency New rate in Hz, 0 for event-driven
+ * @return 0 on success, -ENOENT if tx_id is not registered, -EINVAL if the rate is too high
+ */
+int rp_can_tx_manager_set_frequency(const struct device *mgr, uint16_t tx_id, uint16_t frequency)
+{
+    if (mgr == NULL) {
         return -EINVAL;
     }
-    int frame_index = -1;
-    for (int i = 0; i < data->frame_num; i++) {
-        if (tx_id == data->can_items[i].frame.id) {
-            frame_index = i;
-            break;
-        }
+    if (frequency > CAN_TX_MGR_MAX_FREQ) {
+        LOG_ERR("[can_tx_manager]Invalid frequency %d Hz (max %u Hz)", frequency, CAN_TX_MGR_MAX_FREQ);
+        return -EINVAL;
     }
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
 
-    if (frame_index < 0) {
-        LOG_ERR("[can_tx_manager]Frame for tx_id 0x%03x not found", tx_id);
+    k_mutex_lock(&data->lock, K_FOREVER);
+    rp_can_item_t *item = rp_can_tx_find(data, tx_id);
+    if (item == NULL) {
         k_mutex_unlock(&data->lock);
         return -ENOENT;
     }
-
-    int ret = rp_can_tx_fillbuffer(tx_id, &data->can_items[frame_index].frame, data);
-    if (ret != 0) {
-        k_mutex_unlock(&data->lock);
-        return ret;
+    if (item->frequency != frequency) {
+        rp_can_tx_check_rounding(tx_id, frequency);
+        item->frequency = frequency;
+        rp_can_tx_reschedule(data, item, rp_can_tx_rate(data, item));
+        rp_can_tx_plan(data);
     }
-
-    /* copy the prepared frame locally, then release the lock before
-     * calling can_send so the periodic thread isn't blocked by the driver
-     * while the hardware transmits.  the copy prevents races on frame data.
-     */
-    struct can_frame tmp = data->can_items[frame_index].frame;
     k_mutex_unlock(&data->lock);
-    int send_ret = can_send(cfg->can_dev, &tmp, timeout, callback, user_data);
-    return send_ret;
+    return 0;
 }
 
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+/**
+ * @brief Tag a periodic frame as low priority for the bus-load governor
+ *
+ * @param mgr CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame
+ * @param min_frequency Lowest rate the governor may slow the frame to; 0 clears the tag
+ * @return 0 on success, -ENOENT if tx_id is not registered
+ */
+int rp_can_tx_manager_set_low_priority(const struct device *mgr, uint16_t tx_id, uint16_t min_frequency)
+{
+    if (mgr == NULL) {
+        return -EINVAL;
+    }
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    rp_can_item_t *item = rp_can_tx_find(data, tx_id);
+    if (item == NULL) {
+        k_mutex_unlock(&data->lock);
+        return -ENOENT;
+    }
+    uint16_t before = rp_can_tx_rate(data, item);
+    item->min_frequency = min_frequency;
+    if (rp_can_tx_rate(data, item) != before) {
+        rp_can_tx_reschedule(data, item, rp_can_tx_rate(data, item));
+        rp_can_tx_plan(data);
+    }
+    k_mutex_unlock(&data->lock);
+    return 0;
+}
+
+/* the plan walks up to CAN_TX_MGR_PLAN_HORIZON ticks of every frame, far too long for a tick */
+static void rp_can_tx_plan_work(struct k_work *work)
+{
+    rp_can_tx_data_t *data = CONTAINER_OF(work, rp_can_tx_data_t, plan_work);
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    rp_can_tx_plan(data);
+    k_mutex_unlock(&data->lock);
+}
+
+/**
+ * @brief Slow down or restore the low-priority frames of a bus from its measured load
+ *
+ * Runs in the periodic thread every CONFIG_CAN_TX_MANAGER_GOVERNOR_PERIOD_MS. Above the high
+ * threshold the low-priority rates are halved once more, below the low threshold one halving
+ * is undone; the gap between the thresholds keeps the governor from oscillating. The load
+ * covers the whole bus because the RX manager runs without hardware filters (see Kconfig).
+ *
+ * @param mgr  CAN TX manager device
+ * @param data TX manager data
+ */
+static void rp_can_tx_govern(const struct device *mgr, rp_can_tx_data_t *data)
+{
+    if (data->rx_mgr == NULL) {
+        return;
+    }
+    int load = (int)can_rx_manager_calculate_load(data->rx_mgr, 0, 0);
+    uint8_t shed = data->shed;
+
+    if (load < 0) {
+        return;
+    }
+    if ((load >= CONFIG_CAN_TX_MANAGER_GOVERNOR_HIGH_PERCENT) &&
+        (shed < CONFIG_CAN_TX_MANAGER_GOVERNOR_MAX_SHIFT)) {
+        shed++;
+    } else if ((load <= CONFIG_CAN_TX_MANAGER_GOVERNOR_LOW_PERCENT) && (shed > 0)) {
+        shed--;
+    } else {
+        return;
+    }
+    /* never wait for a registration here, the next period retries */
+    if (k_mutex_lock(&data->lock, K_NO_WAIT) != 0) {
+        return;
+    }
+    data->shed = shed;
+    for (int f = 0; f < CONFIG_MAX_CAN_FRAMES; f++) {
+        rp_can_item_t *item = &data->can_items[f];
+        if (atomic_get(&item->used) && (item->min_frequency != 0)) {
+            rp_can_tx_reschedule(data, item, rp_can_tx_rate(data, item));
+        }
+    }
+    k_mutex_unlock(&data->lock);
+    (void)k_work_submit(&data->plan_work);
+    LOG_INF("[can_tx_manager]%s bus load %d%%, low-priority rates now 1/%u", mgr->name, load,
+            1U << shed);
+}
+#endif
 
-static const struct can_tx_manager_api rp_can_tx_mgr_api = {
-    .register_sender = rp_can_tx_manager_register,
-    .unregister_sender =  rp_can_tx_manager_unregister,
-    .send_frame = rp_can_tx_manager_send,
-};
-
+/**
+ * @brief Merge bytes into the latest frame of an item and publish the result
+ *
+ * @param item    Frame slot
+ * @param offset  First payload byte to write
+ * @param payload Bytes to write
+ * @param len     Number of bytes
+ * @return 0 on success, -EINVAL if the bytes do not fit the DLC
+ */
+static int rp_can_tx_write_item(rp_can_item_t *item, uint8_t offset, const uint8_t *payload, uint8_t len)
+{
+    k_spinlock_key_t key = k_spin_lock(&item->wlock);
+    atomic_val_t seq = atomic_get(&item->seq);
+    struct can_frame *next = &item->buf[(seq + 1) & 1];
+
+    *next = item->buf[seq & 1];
+    if ((uint32_t)offset + len > can_dlc_to_bytes(next->dlc)) {
+        k_spin_unlock(&item->wlock, key);
+        return -EINVAL;
+    }
+    memcpy(&next->data[offset], payload, len);
+    (void)atomic_inc(&item->seq);
+    k_spin_unlock(&item->wlock, key);
+    return 0;
+}
+
+/**
+ * @brief Write part of the payload of a registered frame
+ *
+ * The bytes are merged into the latest frame and published as a whole; the periodic thread
+ * and rp_can_tx_manager_send() pick it up without locking. Writers of the same frame only
+ * serialize among themselves, for a copy of at most 64 bytes.
+ *
+ * @param mgr CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame
+ * @param offset First payload byte to write
+ * @param payload Bytes to write
+ * @param len Number of bytes
+ * @return 0 on success, negative error code on failure
+ */
+int rp_can_tx_manager_write(const struct device *mgr, uint16_t tx_id, uint8_t offset,
+                            const uint8_t *payload, uint8_t len)
+{
+    if ((mgr == NULL) || ((payload == NULL) && (len > 0U))) {
+        return -EINVAL;
+    }
+    rp_can_item_t *item = rp_can_tx_find((rp_can_tx_data_t *)mgr->data, tx_id);
+    if (item == NULL) {
+        return -ENOENT;
+    }
+    return rp_can_tx_write_item(item, offset, payload, len);
+}
+
+/**
+ * @brief Write part of the payload of the frame behind a handle
+ *
+ * Same as rp_can_tx_manager_write() without the tx_id lookup.
+ *
+ * @param mgr CAN TX manager device
+ * @param handle Frame handle returned by rp_can_tx_manager_register()
+ * @param offset First payload byte to write
+ * @param payload Bytes to write
+ * @param len Number of bytes
+ * @return 0 on success, -ENOENT if the frame behind the handle was removed
+ */
+int rp_can_tx_manager_write_handle(const struct device *mgr, int handle, uint8_t offset,
+                                   const uint8_t *payload, uint8_t len)
+{
+    if ((mgr == NULL) || ((payload == NULL) && (len > 0U))) {
+        return -EINVAL;
+    }
+    rp_can_item_t *item = rp_can_tx_from_handle((rp_can_tx_data_t *)mgr->data, handle);
+    if (item == NULL) {
+        return -ENOENT;
+    }
+    return rp_can_tx_write_item(item, offset, payload, len);
+}
+
+/**
+ * @brief Queue the current frame of an item on the bus
+ *
+ * @param mgr CAN TX manager device
+ * @param item Frame slot, or NULL if the lookup failed
+ * @param timeout send timeout
+ * @param callback completion callback
+ * @param user_data user data for callback
+ * @return int
+ */
+static int rp_can_tx_send_item(const struct device *mgr, rp_can_item_t *item, k_timeout_t timeout,
+                               can_tx_callback_t callback, void *user_data)
+{
+    const rp_can_tx_cfg_t *cfg = (const rp_can_tx_cfg_t *)mgr->config;
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
+    if (cfg == NULL || cfg->can_dev == NULL || data == NULL) {
+        LOG_ERR("[can_tx_manager]Invalid CAN TX manager configuration");
+        return -ENODEV;
+    }
+    /* same error can_send() gives, without running the fill callbacks first */
+    if (!rp_can_tx_bus_up(data)) {
+        return -ENETUNREACH;
+    }
+    if (item == NULL) {
+        return -ENOENT;
+    }
+
+    /* send a private copy: producers may publish the next frame while the driver queues it */
+    struct can_frame tmp;
+    int ret = rp_can_tx_take(data, item, &tmp);
+    if (ret != 0) {
+        return ret;
+    }
+    int send_ret = can_send(cfg->can_dev, &tmp, timeout, callback, user_data);
+    if (send_ret == 0) {
+        rp_can_tx_account(data, &tmp);
+    }
+    return send_ret;
+}
+
+/**
+ * @brief Send a CAN frame through the TX manager
+ *
+ * @param mgr CAN TX manager device
+ * @param timeout send timeout
+ * @param callback completion callback
+ * @param tx_id transmit ID
+ * @param user_data user data for callback
+ * @return int
+ */
+int rp_can_tx_manager_send(const struct device *mgr, k_timeout_t timeout, can_tx_callback_t callback, uint16_t tx_id, void *user_data)
+{
+    if (mgr == NULL) {
+        LOG_ERR("[can_tx_manager]CAN TX manager device is NULL");
+        return -EINVAL;
+    }
+    rp_can_item_t *item = rp_can_tx_find((rp_can_tx_data_t *)mgr->data, tx_id);
+    if (item == NULL) {
+        LOG_ERR("[can_tx_manager]Frame for tx_id 0x%03x not found", tx_id);
+    }
+    return rp_can_tx_send_item(mgr, item, timeout, callback, user_data);
+}
+
+/**
+ * @brief Send the frame behind a handle through the TX manager
+ *
+ * @param mgr CAN TX manager device
+ * @param timeout send timeout
+ * @param callback completion callback
+ * @param handle frame handle returned by register
+ * @param user_data user data for callback
+ * @return int
+ */
+int rp_can_tx_manager_send_handle(const struct device *mgr, k_timeout_t timeout, can_tx_callback_t callback, int handle, void *user_data)
+{
+    if (mgr == NULL) {
+        LOG_ERR("[can_tx_manager]CAN TX manager device is NULL");
+        return -EINVAL;
+    }
+    rp_can_item_t *item = rp_can_tx_from_handle((rp_can_tx_data_t *)mgr->data, handle);
+    return rp_can_tx_send_item(mgr, item, timeout, callback, user_data);
+}
+
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+/**
+ * @brief Switch a periodic frame between sending every period and sending on change
+ *
+ * @param mgr CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame
+ * @param max_age_ms Longest time the frame stays off the bus while its payload does not
+ *                   change, rounded up to whole ticks; 0 sends every period again
+ * @return 0 on success, -ENOENT if tx_id is not registered
+ */
+int rp_can_tx_manager_set_on_change(const struct device *mgr, uint16_t tx_id, uint32_t max_age_ms)
+{
+    if (mgr == NULL) {
+        return -EINVAL;
+    }
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    rp_can_item_t *item = rp_can_tx_find(data, tx_id);
+    if (item == NULL) {
+        k_mutex_unlock(&data->lock);
+        return -ENOENT;
+    }
+    uint64_t ticks = DIV_ROUND_UP((uint64_t)max_age_ms * USEC_PER_MSEC, CAN_TX_MGR_TICK_US);
+    item->max_age = (uint32_t)MIN(ticks, UINT32_MAX);
+    item->sent_valid = false;   /* the next due tick sends and starts the comparison */
+    k_mutex_unlock(&data->lock);
+    return 0;
+}
+
+/**
+ * @brief Decide whether a due periodic frame can stay off the bus
+ *
+ * @param data  TX manager data
+ * @param item  Frame slot
+ * @param frame Frame that would be sent
+ * @return true if the receivers already have this payload and it is younger than max_age
+ */
+static bool rp_can_tx_unchanged(const rp_can_tx_data_t *data, const rp_can_item_t *item,
+                                const struct can_frame *frame)
+{
+    if ((item->max_age == 0U) || !item->sent_valid) {
+        return false;
+    }
+    if ((data->ticks - item->sent_tick) >= item->max_age) {
+        return false;           /* refresh for receiver watchdogs */
+    }
+    if ((frame->dlc != item->sent.dlc) || (frame->flags != item->sent.flags)) {
+        return false;
+    }
+    return memcmp(frame->data, item->sent.data, can_dlc_to_bytes(frame->dlc)) == 0;
+}
+#endif
+
+/**
+ * @brief Read the planned and measured per-tick load of the periodic schedule
+ *
+ * @param mgr CAN TX manager device
+ * @param stats Output statistics; the measured peak restarts after each read
+ * @return 0 on success, negative error code on failure
+ */
+int rp_can_tx_manager_get_schedule(const struct device *mgr, struct can_tx_schedule_stats *stats)
+{
+    if ((mgr == NULL) || (stats == NULL)) {
+        return -EINVAL;
+    }
+    const rp_can_tx_cfg_t *cfg = (const rp_can_tx_cfg_t *)mgr->config;
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
+    uint64_t tick_bits = (uint64_t)cfg->bitrate * CAN_TX_MGR_TICK_US / USEC_PER_SEC;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    stats->periodic = 0;
+    for (int f = 0; f < CONFIG_MAX_CAN_FRAMES; f++) {
+        if (atomic_get(&data->can_items[f].used) && (data->can_items[f].frequency != 0)) {
+            stats->periodic++;
+        }
+    }
+    stats->tick_us = CAN_TX_MGR_TICK_US;
+    stats->plan_ticks = data->plan_ticks;
+    stats->peak_frames = data->plan_frames;
+    stats->peak_bits = data->plan_bits;
+    stats->peak_permille = (tick_bits > 0U) ? (uint32_t)((uint64_t)data->plan_bits * 1000U / tick_bits) : 0U;
+    stats->sent_peak = (uint16_t)atomic_clear(&data->sent_peak);
+    stats->sent = data->sent;
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+    stats->sync_sent = (uint32_t)atomic_get(&data->sync_sent);
+    stats->sync_timeouts = (uint32_t)atomic_get(&data->sync_timeouts);
+#else
+    stats->sync_sent = 0U;
+    stats->sync_timeouts = 0U;
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+    stats->governor_shift = data->shed;
+#else
+    stats->governor_shift = 0;
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+    stats->unchanged = data->unchanged;
+#else
+    stats->unchanged = 0U;
+#endif
+    k_mutex_unlock(&data->lock);
+    return 0;
+}
 
 /* empty callback used for non‑blocking sends to keep the periodic
  * thread from being held up by the CAN API */
@@ -386,40 +1331,487 @@ static void can_tx_mgr_tx_cb(const struct device *dev, int error, void *user_dat
     ARG_UNUSED(user_data);
 }
 
+#if CONFIG_CAN_TX_MANAGER_TX_SLOTS > 0
+/**
+ * @brief Map a frame returned by rp_can_tx_manager_reserve() back to its slot
+ *
+ * @param data  TX manager data
+ * @param frame Frame pointer
+ * @return int Slot index, or -EINVAL if the frame is not a reserved slot of this manager
+ */
+static int rp_can_tx_slot_of(rp_can_tx_data_t *data, const struct can_frame *frame)
+{
+    const struct rp_can_tx_slot *slot = CONTAINER_OF(frame, struct rp_can_tx_slot, frame);
+    ptrdiff_t i = slot - data->slots;
+
+    if ((i < 0) || (i >= CONFIG_CAN_TX_MANAGER_TX_SLOTS) || (&data->slots[i] != slot) ||
+        !atomic_test_bit(&data->slot_busy, (int)i)) {
+        return -EINVAL;
+    }
+    return (int)i;
+}
+
+/* completion of a committed slot: report to the caller, then recycle the slot */
+static void rp_can_tx_slot_done(const struct device *dev, int error, void *user_data)
+{
+    struct rp_can_tx_slot *slot = (struct rp_can_tx_slot *)user_data;
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)slot->mgr->data;
+    can_tx_callback_t callback = slot->callback;
+    void *cb_data = slot->user_data;
+
+    atomic_clear_bit(&data->slot_busy, (int)(slot - data->slots));
+    if (callback != NULL) {
+        callback(dev, error, cb_data);
+    }
+}
+
+/**
+ * @brief Lend a TX slot to fill an event frame in place
+ *
+ * The slot comes with the ID, DLC and flags of the frame behind the handle; the caller writes
+ * the payload directly into it and hands it back with rp_can_tx_manager_commit() or
+ * rp_can_tx_manager_release(). Fill callbacks and the published copy of the frame are not
+ * involved. Never blocks.
+ *
+ * @param mgr CAN TX manager device
+ * @param handle Frame handle returned by rp_can_tx_manager_register()
+ * @param frame Output: frame to fill
+ * @return 0 on success, -ENOENT for a stale handle, -ENOBUFS if all slots are in use
+ */
+int rp_can_tx_manager_reserve(const struct device *mgr, int handle, struct can_frame **frame)
+{
+    if ((mgr == NULL) || (frame == NULL)) {
+        return -EINVAL;
+    }
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
+    rp_can_item_t *item = rp_can_tx_from_handle(data, handle);
+    if (item == NULL) {
+        return -ENOENT;
+    }
+
+    atomic_val_t busy;
+    int i;
+    do {
+        busy = atomic_get(&data->slot_busy);
+        /* BIT64_MASK: a full pool of 32 slots must not shift a 32-bit 1 by 32 */
+        if ((uint32_t)busy == (uint32_t)BIT64_MASK(CONFIG_CAN_TX_MANAGER_TX_SLOTS)) {
+            return -ENOBUFS;
+        }
+        i = __builtin_ctz(~(uint32_t)busy);
+    } while (!atomic_cas(&data->slot_busy, busy, busy | (atomic_val_t)BIT(i)));
+
+    /* the header never changes after registration, the buffer being read is irrelevant */
+    struct rp_can_tx_slot *slot = &data->slots[i];
+    slot->frame.id = item->buf[0].id;
+    slot->frame.dlc = item->buf[0].dlc;
+    slot->frame.flags = item->buf[0].flags;
+    slot->mgr = mgr;
+    *frame = &slot->frame;
+    return 0;
+}
+
+/**
+ * @brief Queue a reserved frame; its slot is recycled when the transmission completes
+ *
+ * @param mgr CAN TX manager device
+ * @param frame Frame from rp_can_tx_manager_reserve()
+ * @param timeout send timeout
+ * @param callback completion callback, may be NULL
+ * @param user_data user data for callback
+ * @return int result of can_send(); on error the slot is already recycled
+ */
+int rp_can_tx_manager_commit(const struct device *mgr, struct can_frame *frame, k_timeout_t timeout,
+                             can_tx_callback_t callback, void *user_data)
+{
+    if ((mgr == NULL) || (frame == NULL)) {
+        return -EINVAL;
+    }
+    const rp_can_tx_cfg_t *cfg = (const rp_can_tx_cfg_t *)mgr->config;
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
+    int i = rp_can_tx_slot_of(data, frame);
+    if (i < 0) {
+        return i;
+    }
+    struct rp_can_tx_slot *slot = &data->slots[i];
+    int ret = -ENETUNREACH;
+
+    slot->callback = callback;
+    slot->user_data = user_data;
+    if (rp_can_tx_bus_up(data)) {
+        ret = can_send(cfg->can_dev, &slot->frame, timeout, rp_can_tx_slot_done, slot);
+    }
+    if (ret != 0) {
+        atomic_clear_bit(&data->slot_busy, i);
+        return ret;
+    }
+    rp_can_tx_account(data, frame);
+    return 0;
+}
+
+/**
+ * @brief Give a reserved frame back without sending it
+ *
+ * @param mgr CAN TX manager device
+ * @param frame Frame from rp_can_tx_manager_reserve()
+ * @return 0 on success, -EINVAL if the frame is not a reserved slot of this manager
+ */
+int rp_can_tx_manager_release(const struct device *mgr, struct can_frame *frame)
+{
+    if ((mgr == NULL) || (frame == NULL)) {
+        return -EINVAL;
+    }
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
+    int i = rp_can_tx_slot_of(data, frame);
+    if (i < 0) {
+        return i;
+    }
+    atomic_clear_bit(&data->slot_busy, i);
+    return 0;
+}
+#endif
+
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+/**
+ * @brief Put a synchronized frame on the bus (sync work queue)
+ *
+ * Frames of synchronized items have no fill callback, so the latest published copy is sent
+ * as is. Cycles closed while a send was still queued are merged into that send.
+ *
+ * @param work Work item of the frame
+ */
+static void rp_can_tx_sync_work(struct k_work *work)
+{
+    struct rp_can_tx_sync *sync = CONTAINER_OF(work, struct rp_can_tx_sync, work);
+    rp_can_item_t *item = CONTAINER_OF(sync, rp_can_item_t, sync);
+    const rp_can_tx_cfg_t *cfg = (const rp_can_tx_cfg_t *)sync->mgr->config;
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)sync->mgr->data;
+    atomic_val_t due = atomic_clear(&sync->due);
+
+    /* like the periodic path: nothing goes out while bus-off, the fallback timer keeps running */
+    if ((due == 0) || !rp_can_tx_bus_up(data)) {
+        return;
+    }
+
+    struct can_frame frame;
+    rp_can_tx_snapshot(item, &frame);
+    if (can_send(cfg->can_dev, &frame, K_NO_WAIT, can_tx_mgr_tx_cb, NULL) == 0) {
+        rp_can_tx_account(data, &frame);
+        bool fed = ((due & RP_CAN_TX_SYNC_FED) != 0);
+        (void)atomic_inc(fed ? &data->sync_sent : &data->sync_timeouts);
+    }
+}
+
+/**
+ * @brief Close one cycle of a synchronized frame and queue its send (ISR context)
+ *
+ * Runs from the feedback listener or the timer and only does the group bookkeeping; the
+ * frame goes out from the sync work queue.
+ *
+ * @param item Frame slot
+ */
+static void rp_can_tx_sync_fire(rp_can_item_t *item)
+{
+    struct rp_can_tx_sync *sync = &item->sync;
+    bool fed = (atomic_clear(&sync->fed) != 0);
+
+    if (!fed) {
+        (void)atomic_clear(&sync->seen);    /* a group that never completed starts over */
+    }
+    /* the fallback of the next cycle, restarted at the offset if the feedback comes first */
+    if (sync->timeout_us != 0U) {
+        k_timer_start(&sync->timer, K_USEC(sync->timeout_us), K_NO_WAIT);
+    }
+    (void)atomic_or(&sync->due, fed ? RP_CAN_TX_SYNC_FED : RP_CAN_TX_SYNC_TIMEOUT);
+    (void)k_work_submit_to_queue(&s_tx_sync_wq, &sync->work);
+}
+
+static void rp_can_tx_sync_expiry(struct k_timer *timer)
+{
+    struct rp_can_tx_sync *sync = CONTAINER_OF(timer, struct rp_can_tx_sync, timer);
+
+    rp_can_tx_sync_fire(CONTAINER_OF(sync, rp_can_item_t, sync));
+}
+
+/**
+ * @brief Feedback listener of a synchronized frame (ISR context)
+ *
+ * Marks the feedback ID; the listener completing the group schedules the frame.
+ *
+ * @param frame Feedback frame
+ * @param user_data Frame slot
+ */
+static void rp_can_tx_sync_rx(const struct can_frame *frame, void *user_data)
+{
+    rp_can_item_t *item = (rp_can_item_t *)user_data;
+    struct rp_can_tx_sync *sync = &item->sync;
+    uint32_t bit = 0;
+
+    for (int i = 0; i < sync->rx_num; i++) {
+        if (sync->rx_ids[i] == frame->id) {
+            bit = BIT(i);
+            break;
+        }
+    }
+    if ((((uint32_t)atomic_or(&sync->seen, bit) | bit) != sync->all) ||
+        !atomic_cas(&sync->seen, sync->all, 0)) {
+        return;                 /* group incomplete, or another listener already fired it */
+    }
+    atomic_set(&sync->fed, 1);
+    if (sync->offset_us == 0U) {
+        rp_can_tx_sync_fire(item);
+    } else {
+        k_timer_start(&sync->timer, K_USEC(sync->offset_us), K_NO_WAIT);
+    }
+}
+
+/**
+ * @brief Send a frame a fixed offset after the feedback of its motors instead of periodically
+ *
+ * @param mgr CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame without fill callbacks
+ * @param rx_ids Feedback IDs that make up one cycle
+ * @param rx_num Number of feedback IDs; 0 returns the frame to its periodic schedule
+ * @param offset_us Delay from the last feedback of a cycle to the frame
+ * @param timeout_us Longest gap between two sends when feedback is missing, 0 for none
+ * @return 0 on success, negative error code on failure
+ */
+int rp_can_tx_manager_set_sync(const struct device *mgr, uint16_t tx_id, const uint32_t *rx_ids,
+                               uint8_t rx_num, uint32_t offset_us, uint32_t timeout_us)
+{
+    if ((mgr == NULL) || (rx_num > CONFIG_CAN_TX_MANAGER_SYNC_MAX_IDS) ||
+        ((rx_ids == NULL) && (rx_num > 0U))) {
+        return -EINVAL;
+    }
+    rp_can_tx_data_t *data = (rp_can_tx_data_t *)mgr->data;
+    if (data->rx_mgr == NULL) {
+        LOG_ERR("[can_tx_manager]%s has no RX manager to take feedback from", mgr->name);
+        return -ENODEV;
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    rp_can_item_t *item = rp_can_tx_find(data, tx_id);
+    if (item == NULL) {
+        k_mutex_unlock(&data->lock);
+        return -ENOENT;
+    }
+    if (item->cb_num != 0) {
+        LOG_ERR("[can_tx_manager]tx_id 0x%03x has fill callbacks, write its payload instead", tx_id);
+        k_mutex_unlock(&data->lock);
+        return -ENOTSUP;
+    }
+
+    struct rp_can_tx_sync *sync = &item->sync;
+    int ret = 0;
+
+    rp_can_tx_sync_stop(data, item);
+    sync->mgr = mgr;
+    sync->offset_us = offset_us;
+    sync->timeout_us = timeout_us;
+    sync->all = (uint32_t)BIT64_MASK(rx_num);     /* rx_num may be 32 */
+    atomic_clear(&sync->seen);
+    atomic_clear(&sync->fed);
+    atomic_clear(&sync->due);
+    k_timer_init(&sync->timer, rp_can_tx_sync_expiry, NULL);
+    k_work_init(&sync->work, rp_can_tx_sync_work);
+    for (uint8_t i = 0; i < rx_num; i++) {
+        struct can_filter filter = {
+            .id = rx_ids[i],
+            .mask = (rx_ids[i] > CAN_STD_ID_MASK) ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK,
+            .flags = (rx_ids[i] > CAN_STD_ID_MASK) ? CAN_FILTER_IDE : 0,
+        };
+        /* ISR listeners: the cycle is closed in the reception interrupt, the send is queued */
+        ret = can_rx_manager_register_flags(data->rx_mgr, &filter, rp_can_tx_sync_rx, item,
+                                            CAN_RX_LISTENER_ISR);
+        if (ret < 0) {
+            LOG_ERR("[can_tx_manager]tx_id 0x%03x: feedback 0x%03x not registered, err %d",
+                    tx_id, rx_ids[i], ret);
+            rp_can_tx_sync_stop(data, item);
+            break;
+        }
+        sync->rx_ids[i] = rx_ids[i];
+        sync->listeners[i] = ret;
+        sync->rx_num = i + 1U;
+    }
+    /* synchronized frames leave the periodic schedule; rx_num == 0 brings them back */
+    rp_can_tx_reschedule(data, item, rp_can_tx_rate(data, item));
+    rp_can_tx_plan(data);
+    if ((sync->rx_num != 0) && (timeout_us != 0U)) {
+        k_timer_start(&sync->timer, K_USEC(timeout_us), K_NO_WAIT);
+    }
+    k_mutex_unlock(&data->lock);
+    return (ret < 0) ? ret : 0;
+}
+#endif
+
+static const struct can_tx_manager_api rp_can_tx_mgr_api = {
+    .register_sender = rp_can_tx_manager_register,
+    .unregister_sender =  rp_can_tx_manager_unregister,
+    .send_frame = rp_can_tx_manager_send,
+    .write_data = rp_can_tx_manager_write,
+    .send_handle = rp_can_tx_manager_send_handle,
+    .write_handle = rp_can_tx_manager_write_handle,
+    .get_schedule = rp_can_tx_manager_get_schedule,
+    .set_frequency = rp_can_tx_manager_set_frequency,
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+    .set_low_priority = rp_can_tx_manager_set_low_priority,
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_SYNC)
+    .set_sync = rp_can_tx_manager_set_sync,
+#endif
+#if CONFIG_CAN_TX_MANAGER_TX_SLOTS > 0
+    .reserve = rp_can_tx_manager_reserve,
+    .commit = rp_can_tx_manager_commit,
+    .release = rp_can_tx_manager_release,
+#endif
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+    .set_on_change = rp_can_tx_manager_set_on_change,
+#endif
+};
+
+
+/* One tick source for all schedulers: the shared thread and every `dedicated-tx-thread` instance */
+#define RP_CAN_TX_MGR_SEM_DEFINE(inst) \
+    IF_ENABLED(DT_INST_PROP(inst, dedicated_tx_thread), (static K_SEM_DEFINE(rp_can_tx_sem_##inst, 0, 1);))
+#define RP_CAN_TX_MGR_SEM_PTR(inst) \
+    IF_ENABLED(DT_INST_PROP(inst, dedicated_tx_thread), (&rp_can_tx_sem_##inst,))
+
+DT_INST_FOREACH_STATUS_OKAY(RP_CAN_TX_MGR_SEM_DEFINE)
+
+#if RP_CAN_TX_MGR_SHARED_USERS > 0
 static K_SEM_DEFINE(s_tx_tick_sem, 0, 1);
+
+#define RP_CAN_TX_MGR_SHARED_PTR(inst) \
+    IF_DISABLED(DT_INST_PROP(inst, dedicated_tx_thread), (DEVICE_DT_INST_GET(inst),))
+
+static const struct device *const s_tx_shared_devs[] = {
+    DT_INST_FOREACH_STATUS_OKAY(RP_CAN_TX_MGR_SHARED_PTR)
+};
+#endif
+
+static struct k_sem *const s_tx_tick_sems[] = {
+#if RP_CAN_TX_MGR_SHARED_USERS > 0
+    &s_tx_tick_sem,
+#endif
+    DT_INST_FOREACH_STATUS_OKAY(RP_CAN_TX_MGR_SEM_PTR)
+};
+
+static atomic_t s_tx_tick_started = ATOMIC_INIT(0);
+
+/**
+ * @brief wake every scheduler thread for one tick (ISR context)
+ */
+static inline void can_tx_tick_give(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(s_tx_tick_sems); i++) {
+        k_sem_give(s_tx_tick_sems[i]);
+    }
+}
+
+#if defined(CONFIG_CAN_TX_MANAGER_TIMER_COUNTER)
+static const struct device *const s_tx_counter = DEVICE_DT_GET(DT_CHOSEN(rp_can_tx_timer));
+
+/**
+ * @brief counter top value callback (ISR context)
+ *        merely gives a semaphore; avoid doing work in ISR.
+ */
+static void can_tx_counter_top(const struct device *dev, void *user_data)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(user_data);
+    can_tx_tick_give();
+}
+
+/**
+ * @brief start the periodic tick on the rp,can-tx-timer counter
+ *
+ * The counter wraps at the tick period, so the period is exact to one counter tick and
+ * independent of the kernel tick.
+ *
+ * @return 0 on success, negative error code on failure
+ */
+static int can_tx_tick_start(void)
+{
+    if (!device_is_ready(s_tx_counter)) {
+        return -ENODEV;
+    }
+    const struct counter_top_cfg top = {
+        .ticks = counter_us_to_ticks(s_tx_counter, CAN_TX_MGR_TICK_US),
+        .callback = can_tx_counter_top,
+        .user_data = NULL,
+        .flags = 0,
+    };
+    if ((top.ticks == 0U) || (top.ticks > counter_get_max_top_value(s_tx_counter))) {
+        return -ERANGE;
+    }
+    int ret = counter_set_top_value(s_tx_counter, &top);
+    if (ret != 0) {
+        return ret;
+    }
+    return counter_start(s_tx_counter);
+}
+#else
 static struct k_timer s_tx_timer;
 
 /**
- * @brief hardware timer expiry callback (ISR context)
+ * @brief kernel timer expiry callback (ISR context)
  *        merely gives a semaphore; avoid doing work in ISR.
  */
 static void can_tx_timer_expiry(struct k_timer *timer)
 {
     ARG_UNUSED(timer);
-    k_sem_give(&s_tx_tick_sem);
+    can_tx_tick_give();
 }
 
+/**
+ * @brief start the periodic tick on a kernel timer
+ *
+ * @return 0
+ */
+static int can_tx_tick_start(void)
+{
+    k_timer_init(&s_tx_timer, can_tx_timer_expiry, NULL);
+    k_timer_start(&s_tx_timer, K_USEC(CAN_TX_MGR_TICK_US), K_USEC(CAN_TX_MGR_TICK_US));
+    return 0;
+}
+#endif
+
 /**
  * @brief periodic transmission thread
- *        triggered by the hardware timer at a fixed rate (see CAN_TX_MGR_TICK_MS).
- *        iterates every enabled TX manager instance and sends any due frames.
+ *        triggered by the tick source at a fixed rate (see CAN_TX_MGR_TICK_US).
+ *        iterates the TX manager instances it schedules and sends any due frames:
+ *        all instances without `dedicated-tx-thread`, or the one instance it is dedicated to.
+ *
+ * @param p1 array of TX manager devices
+ * @param p2 number of devices
+ * @param p3 tick semaphore of this thread
  */
 static void can_tx_manager_thread(void *p1, void *p2, void *p3)
 {
-    ARG_UNUSED(p1);
-    ARG_UNUSED(p2);
-    ARG_UNUSED(p3);
+    const struct device *const *devs = (const struct device *const *)p1;
+    const int dev_count = (int)(uintptr_t)p2;
+    struct k_sem *tick_sem = (struct k_sem *)p3;
 
-    static const struct device *const devs[] = {
-        DT_INST_FOREACH_STATUS_OKAY(_RP_CAN_TX_MGR_DEV_PTR)
-    };
-    static const int dev_count = ARRAY_SIZE(devs);
-
-    k_timer_init(&s_tx_timer, can_tx_timer_expiry, NULL);
-    k_timer_start(&s_tx_timer, K_MSEC(CAN_TX_MGR_TICK_MS), K_MSEC(CAN_TX_MGR_TICK_MS));
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+    const uint32_t gov_ticks = MAX(CONFIG_CAN_TX_MANAGER_GOVERNOR_PERIOD_MS * USEC_PER_MSEC / CAN_TX_MGR_TICK_US, 1U);
+    uint32_t gov_count = 0;
+#endif
+    /* the first scheduler to run starts the tick shared by all of them */
+    if (atomic_cas(&s_tx_tick_started, 0, 1)) {
+        int err = can_tx_tick_start();
+        if (err != 0) {
+            LOG_ERR("[can_tx_manager]Failed to start the TX tick (%u us), err %d", CAN_TX_MGR_TICK_US, err);
+            return;
+        }
+    }
 
     while (1) {
-        k_sem_take(&s_tx_tick_sem, K_FOREVER);
+        k_sem_take(tick_sem, K_FOREVER);
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+        bool govern = (++gov_count >= gov_ticks);
+        if (govern) {
+            gov_count = 0;
+        }
+#endif
 
         for (int d = 0; d < dev_count; d++) {
             const struct device *mgr = devs[d];
@@ -429,45 +1821,121 @@ static void can_tx_manager_thread(void *p1, void *p2, void *p3)
                 continue;
             }
 
-            k_mutex_lock(&data->lock, K_FOREVER);
-            for (int f = 0; f < data->frame_num; f++) {
-                rp_can_item_t *item = &data->can_items[f];
-
-                /* frequency == 0: event-driven, skip in periodic thread */
-                if (item->frequency == 0) {
-                    continue;
+            /* while the bus is off the RX manager recovers it; keep the schedule, send nothing */
+            bool up = rp_can_tx_bus_up(data);
+            if (up == data->bus_down) {
+                if (up) {
+                    LOG_INF("[can_tx_manager]%s bus back, %u periodic frames skipped", mgr->name,
+                            data->bus_skipped);
+                } else {
+                    LOG_WRN("[can_tx_manager]%s bus-off, periodic frames paused", mgr->name);
                 }
-
-                item->tick_counter++;
-                if (item->tick_counter < item->interval) {
-                    continue;
+                data->bus_down = !up;
+                data->bus_skipped = 0;
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+                /* receivers may have restarted during the outage: resend every on-change frame */
+                for (int f = 0; f < CONFIG_MAX_CAN_FRAMES; f++) {
+                    data->can_items[f].sent_valid = false;
                 }
-                item->tick_counter = 0;
+#endif
+            }
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+            data->ticks++;
+#endif
+            uint16_t sent = 0;
+            /* no manager lock here: slots are stable and frames are taken from their double buffer */
+            for (int w = 0; w < ATOMIC_BITMAP_SIZE(CONFIG_MAX_CAN_FRAMES); w++) {
+                /* only used slots: the cost per tick follows the registered frames */
+                unsigned long active = (unsigned long)atomic_get(&data->active[w]);
+                while (active != 0UL) {
+                    int f = w * ATOMIC_BITS + __builtin_ctzl(active);
+                    active &= active - 1UL;
+                    rp_can_item_t *item = &data->can_items[f];
 
-                uint16_t tx_id = (uint16_t)item->frame.id;
-                int ret = rp_can_tx_fillbuffer(tx_id, &item->frame, data);
-                if (ret != 0) {
-                    continue; /* no callback or fill failed, skip this frame */
-                }
-                ret = can_send(cfg->can_dev, &item->frame, K_NO_WAIT,
-                               can_tx_mgr_tx_cb, NULL);
-                if (ret != 0) {
-                    LOG_ERR("[can_tx_manager]Periodic can_send failed for tx_id 0x%03x, err %d", tx_id, ret);
+                    if (atomic_get(&item->resched) != 0) {
+                        /* interval and phase switch together, on a tick boundary */
+                        atomic_val_t rs = atomic_clear(&item->resched);
+                        item->interval = (uint16_t)((rs >> 16) & 0x7FFF);
+                        item->tick_counter = (uint16_t)(rs & 0xFFFF);
+                    }
+                    /* interval == 0: event-driven, skip in periodic thread */
+                    if (!atomic_get(&item->used) || (item->interval == 0)) {
+                        continue;
+                    }
+
+                    if (item->tick_counter > 0) {
+                        item->tick_counter--;
+                        continue;
+                    }
+                    item->tick_counter = item->interval - 1;
+                    if (data->bus_down) {
+                        data->bus_skipped++;
+                        continue;
+                    }
+
+                    uint16_t tx_id = item->id;
+                    struct can_frame frame;
+                    int ret = rp_can_tx_take(data, item, &frame);
+                    if (ret != 0) {
+                        continue; /* fill failed, skip this frame */
+                    }
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+                    if (rp_can_tx_unchanged(data, item, &frame)) {
+                        data->unchanged++;
+                        continue;
+                    }
+#endif
+                    ret = can_send(cfg->can_dev, &frame, K_NO_WAIT,
+                                   can_tx_mgr_tx_cb, NULL);
+                    if ((ret == -ENETUNREACH) || (ret == -ENETDOWN)) {
+                        data->bus_skipped++;        /* bus-off or stopped: not worth a log line per frame */
+                    } else if (ret != 0) {
+                        LOG_ERR("[can_tx_manager]Periodic can_send failed for tx_id 0x%03x, err %d", tx_id, ret);
+                    } else {
+                        rp_can_tx_account(data, &frame);
+                        data->sent++;
+                        sent++;
+#if defined(CONFIG_CAN_TX_MANAGER_ON_CHANGE)
+                        item->sent = frame;
+                        item->sent_tick = data->ticks;
+                        item->sent_valid = true;
+#endif
+                    }
                 }
             }
-            k_mutex_unlock(&data->lock);
+            if (sent > atomic_get(&data->sent_peak)) {
+                atomic_set(&data->sent_peak, sent);
+            }
+#if defined(CONFIG_CAN_TX_MANAGER_GOVERNOR)
+            if (govern) {
+                rp_can_tx_govern(mgr, data);
+            }
+#endif
         }
     }
 }
 
+#if RP_CAN_TX_MGR_SHARED_USERS > 0
 K_THREAD_DEFINE(can_tx_mgr_thread, CONFIG_CAN_TX_MANAGER_THREAD_STACK_SIZE,
-                can_tx_manager_thread, NULL, NULL, NULL,
+                can_tx_manager_thread, s_tx_shared_devs, ARRAY_SIZE(s_tx_shared_devs), &s_tx_tick_sem,
                 CONFIG_CAN_TX_MANAGER_THREAD_PRIORITY, 0, 0);
+#endif
 
+/* Per-bus scheduler thread, only emitted for instances with `dedicated-tx-thread` */
+#define RP_CAN_TX_MGR_DEDICATED_DEFINE(inst)                                                    \
+    static const struct device *const rp_can_tx_devs_##inst[] = {DEVICE_DT_INST_GET(inst)};     \
+    K_THREAD_DEFINE(can_tx_mgr_thread_##inst,                                                   \
+                    DT_INST_PROP_OR(inst, tx_stack_size, CONFIG_CAN_TX_MANAGER_THREAD_STACK_SIZE), \
+                    can_tx_manager_thread, rp_can_tx_devs_##inst, 1, &rp_can_tx_sem_##inst,     \
+                    DT_INST_PROP_OR(inst, tx_thread_priority, CONFIG_CAN_TX_MANAGER_THREAD_PRIORITY), \
+                    0, 0);
 
 #define RP_CAN_TX_MGR_DEFINE(inst)                                                              \
+    IF_ENABLED(DT_INST_PROP(inst, dedicated_tx_thread), (RP_CAN_TX_MGR_DEDICATED_DEFINE(inst))) \
     static const struct rp_can_tx_cfg rp_can_tx_mgr_cfg_##inst = {                      \
         .can_dev = DEVICE_DT_GET(DT_INST_PHANDLE(inst, can_bus)),                               \
+        .bitrate = DT_PROP_OR(DT_INST_PHANDLE(inst, can_bus), bitrate, 1000000),                \
+        .bitrate_data = DT_PROP_OR(DT_INST_PHANDLE(inst, can_bus), bitrate_data, 0),            \
     };                                                                                          \
     static struct rp_can_tx_data rp_can_tx_mgr_data_##inst;                             \
     DEVICE_DT_INST_DEFINE(inst, rp_can_tx_manager_init, NULL, &rp_can_tx_mgr_data_##inst,       \
@@ -23,6 +23,11 @@ static void motor_dji_hb_work_handler(struct k_work *work)
     struct k_work_delayable *dwork = k_work_delayable_from_work(work);           // 获取 k_work_delayable 指针
     motor_dji_data_t *data = CONTAINER_OF(dwork, motor_dji_data_t, hb_work);    // 获取 motor_dji_data_t 指针
 
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+    if (data->hb_watched) {
+        return;     // 已交给 RX 管理器监视，停止轮询
+    }
+#endif
     if (data->dev_self != NULL) {
         (void)motor_dji_update_heartbeat_status(data->dev_self);
         (void)k_work_schedule(&data->hb_work, K_MSEC(CONFIG_MOTOR_HEARTBEAT_POLL_PERIOD_MS));   // 重新调度下一次心跳检测
@@ -33,12 +38,15 @@ static void motor_dji_hb_work_handler(struct k_work *work)
 
 /**
  * @brief CAN 接收回调函数，在注册电机之后将会自动开始接收对应 ID 的 CAN 帧
+ *        开启 CONFIG_MOTOR_RX_IN_ISR 时在 CAN 中断中执行，不可阻塞
  *
  * @param frame
+ * @param meta      帧到达中断时采样的时间，回调可能晚于到达时刻执行
  * @param user_data
  */
 #if defined(CONFIG_CAN_RX_MANAGER)
-static void motor_dji_can_rx_handler(const struct can_frame *frame, void *user_data)
+static void motor_dji_can_rx_handler(const struct can_frame *frame, const struct can_rx_meta *meta,
+                                     void *user_data)
 {
     const struct device *motor_dev = (const struct device *)user_data;
     if ((motor_dev == NULL) || (frame == NULL))
@@ -88,73 +96,30 @@ static void motor_dji_can_rx_handler(const struct can_frame *frame, void *user_d
             break;
         }
     }
-    data->motor_data.heartbeat_status.heartbeat_tick = (uint64_t)k_uptime_get();       // 更新心跳时间戳
+    data->motor_data.heartbeat_status.heartbeat_tick = (uint64_t)can_rx_meta_uptime_ms(meta);  // 心跳时间戳取帧到达时刻
+    data->motor_data.heartbeat_status.rx_cycles = meta->rx_cycles;                      // 供测速/延迟测量使用
     k_spin_unlock(&data->lock, key);                           // 解锁
 }
 #endif
 
 
+#if defined(CONFIG_CAN_TX_MANAGER)
 /**
- * @brief
- * @param frame
- * @param user_data
- * @return int
+ * @brief 计算本电机在共享控制帧里的字节偏移：0x200/0x1FF 等一帧带 4 个电机，每个电机 2 字节，
+ *        位置由反馈 ID 的末位决定（1~4 / 5~8）
+ *
+ * @param cfg
+ * @return int 字节偏移（0/2/4/6），<0: 错误码
  */
-#if defined(CONFIG_CAN_TX_MANAGER)
-static int motor_dji_can_tx_fillbuffer_handler(struct can_frame *frame, void *user_data)
+static int motor_dji_can_tx_offset(const motor_dji_cfg_t *cfg)
 {
-    const struct device *motor = (const struct device *)user_data; // 还原 motor 指针
-    if ((motor == NULL) || (frame == NULL))
-    {
-        LOG_ERR("[dji_motor_err] tx handle Invalid arguments");
+    int diff = cfg->rx_id % 10;
+    if (diff <= 0 || diff > 8) {
+        LOG_ERR("[dji_motor_err] tx invalid id difference: tx_id=%d, rx_id=%d", cfg->tx_id, cfg->rx_id);
         return -EINVAL;
     }
-    motor_dji_data_t *data = (motor_dji_data_t *)motor->data;
-    const motor_dji_cfg_t *cfg = (const motor_dji_cfg_t *)motor->config;
-    if (data == NULL || cfg == NULL)
-    {
-        LOG_ERR("[dji_motor_err] tx handle data or cfg NULL");
-        return -EINVAL;
-    }
-    // LOG_INF("motor tx fillbuffer handler called, control_mode=%d, tx_id=%03X", cfg->control_mode, cfg->tx_id);
-    switch (cfg->control_mode)
-    {
-        case 0: // torque
-        case 1: // velocity
-        {
-            frame->dlc = 8;
-            frame->flags = 0;
-            k_spinlock_key_t key = k_spin_lock(&data->lock);
-            int diff = cfg->rx_id % 10;
-            if (diff <= 0 || diff > 8) {
-                LOG_ERR("[dji_motor_err] tx handle invalid id difference: tx_id=%d, rx_id=%d", cfg->tx_id, cfg->rx_id);
-                k_spin_unlock(&data->lock, key);
-                return -EINVAL;
-            }
-            int off = (diff > 4) ? (diff - 4) : diff;
-            if (off <= 0 || off > 4) {
-                LOG_ERR("[dji_motor_err] tx handle computed off out of range: %d", off);
-                k_spin_unlock(&data->lock, key);
-                return -EINVAL;
-            }
-            int idx = 2 * (off - 1);
-            if ((idx + 2) > 8) {
-                LOG_ERR("[dji_motor_err] tx handle target index overflow: idx=%d", idx);
-                k_spin_unlock(&data->lock, key);
-                return -EFAULT;
-            }
-            memcpy(&frame->data[idx], &data->motor_data.tx_data[0], 2);
-            k_spin_unlock(&data->lock, key);
-            return 0;
-        }
-        default:
-        {
-            LOG_ERR("[dji_motor_err] tx handle unknown control mode: %d", cfg->control_mode);
-            return -EINVAL;
-        }
-    }
-    return -EINVAL; // should not reach here
-    return 0;
+    int off = (diff > 4) ? (diff - 4) : diff;
+    return 2 * (off - 1);
 }
 #endif
 
@@ -192,10 +157,65 @@ static int motor_dji_can_control(const struct device *dev, int16_t current)
             return -EINVAL;
     }
     k_spin_unlock(&data->lock, key);
+#if defined(CONFIG_CAN_TX_MANAGER)
+    /* 直接写进 TX 管理器的帧缓冲，发送线程不再回调电机、也不再持锁 */
+    int idx = motor_dji_can_tx_offset(cfg);
+    if (idx < 0) {
+        return idx;
+    }
+    uint8_t payload[2] = {(uint8_t)((current >> 8) & 0xFF), (uint8_t)(current & 0xFF)};
+    return can_tx_manager_write_handle(cfg->tx_mgr, data->tx_handle, (uint8_t)idx, payload, sizeof(payload));
+#else
     return 0;
+#endif
 }
 
 
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+/**
+ * @brief RX 管理器的 liveness 回调：反馈帧恢复/迟到/超时离线时调用（中断上下文，不可阻塞）
+ *
+ * @param listener_id
+ * @param state
+ * @param user_data 电机设备
+ */
+static void motor_dji_liveness_cb(int listener_id, enum can_rx_liveness state, void *user_data)
+{
+    ARG_UNUSED(listener_id);
+    const struct device *dev = (const struct device *)user_data;
+    const motor_dji_cfg_t *cfg = dev->config;
+    motor_dji_data_t *data = dev->data;
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    bool prev_alive = data->motor_data.heartbeat_status.is_alive;
+
+    switch (state) {
+        case CAN_RX_LIVE_ONLINE:
+            data->motor_data.heartbeat_status.is_alive = true;
+            break;
+        case CAN_RX_LIVE_LATE:
+            /* 超过学习到的周期但未到离线超时，仍视为在线，只提示 */
+            LOG_WRN_RATELIMIT_RATE(1000, "[dji_motor] feedback late (%s, rx=0x%03x)",
+                                   cfg->motor_label, (unsigned int)cfg->rx_id);
+            break;
+        case CAN_RX_LIVE_OFFLINE:
+            data->motor_data.heartbeat_status.is_alive = false;
+            if (prev_alive) {
+                memset(&data->motor_data.rx_data, 0, sizeof(data->motor_data.rx_data));
+                LOG_ERR("[dji_motor_err] motor offline (%s, rx=0x%03x): no CAN frames for %d ms",
+                        cfg->motor_label, (unsigned int)cfg->rx_id, CONFIG_MOTOR_HEARTBEAT_OFFLINE_TIMEOUT_MS);
+            } else {
+                LOG_WRN("[dji_motor_err] motor offline! no first CAN frame received (%s, rx=0x%03x)",
+                        cfg->motor_label, (unsigned int)cfg->rx_id);
+            }
+            break;
+        default:
+            break;
+    }
+    k_spin_unlock(&data->lock, key);
+}
+#endif
+
 /**
  * @brief dji motor 心跳状态更新函数，供应用层/中间件调用以获取最新心跳状态.
  *        这个函数既可以在应用层创建线程调用，也可以启动自动检测（CONFIG_MOTOR_DJI_HEARTBEAT_AUTOCHECK）
@@ -216,6 +236,11 @@ int motor_dji_update_heartbeat_status(const struct device *dev)
         return -EINVAL;
     }
 
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+    if (data->hb_watched) {
+        return 0;   // 在线状态由 motor_dji_liveness_cb 维护
+    }
+#endif
     const motor_dji_cfg_t *cfg = (const motor_dji_cfg_t *)data->motor_data.interface_ptr;
     uint64_t current_tick = (uint64_t)k_uptime_get();
 
@@ -305,13 +330,24 @@ static int motor_dji_can_register_motor(const struct device *dev)
     int rx_ret = -1;
 
 #if defined(CONFIG_CAN_RX_MANAGER) // 将电机接收交给 CAN RX 管理器处理
-    rx_ret = can_rx_manager_register(cfg->rx_mgr, &filter, motor_dji_can_rx_handler, (void *)dev);
+    rx_ret = can_rx_manager_register_ts(cfg->rx_mgr, &filter, motor_dji_can_rx_handler, (void *)dev,
+                                        IS_ENABLED(CONFIG_MOTOR_RX_IN_ISR) ? CAN_RX_LISTENER_ISR :
+                                        IS_ENABLED(CONFIG_CAN_RX_MANAGER_MAILBOX) ? CAN_RX_LISTENER_MAILBOX : 0U);
     if (rx_ret < 0) {
         LOG_ERR("[dji_motor_err] Failed to register motor on RxManager: %d", rx_ret);
         return rx_ret;
     }
     else LOG_INF("Motor (%s) registered on RxManager, CAN RX ID: 0x%03X  slotID: %d", cfg->motor_label, cfg->rx_id, rx_ret);
     data->rxmanager_slot_id = rx_ret;
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+    /* 由 RX 管理器学习反馈周期并按总线统一定时检测离线，代替每个电机一个轮询 work */
+    int watch_ret = can_rx_manager_watch(cfg->rx_mgr, rx_ret, CONFIG_MOTOR_HEARTBEAT_OFFLINE_TIMEOUT_MS,
+                                         motor_dji_liveness_cb, (void *)dev);
+    if (watch_ret < 0) {
+        LOG_WRN("[dji_motor] liveness watch unavailable (%d), falling back to polling", watch_ret);
+    }
+    data->hb_watched = (watch_ret == 0);
+#endif
 #else 
     LOG_INF("Motor (%s) did not register on RxManager, CAN RX ID: 0x%03X", cfg->motor_label, cfg->rx_id);
 #endif
@@ -319,13 +355,18 @@ static int motor_dji_can_register_motor(const struct device *dev)
 
 #if defined(CONFIG_CAN_TX_MANAGER)
     int tx_ret = -1;
+    if (motor_dji_can_tx_offset(cfg) < 0) {
+        return -EINVAL;
+    }
+    /* 同一 tx_id 的电机共用一帧，各自通过 can_tx_manager_write 写入自己的 2 字节 */
     tx_ret = can_tx_manager_register(cfg->tx_mgr, cfg->tx_id, cfg->rx_id, 8, 0, data->Tx_feq,
-                                        motor_dji_can_tx_fillbuffer_handler, (void *)dev);
+                                        NULL, (void *)dev);
     if (tx_ret < 0) {
         LOG_ERR("[dji_motor_err] Failed to register CAN TX filter: %d", tx_ret);
         return tx_ret;
     }
     else LOG_INF("Motor (%s) registered on TxManager, CAN TX ID: 0x%03X", cfg->motor_label, cfg->tx_id);
+    data->tx_handle = tx_ret;
 #else
     LOG_INF("Motor (%s) did not register on TxManager, CAN TX ID: 0x%03X", cfg->motor_label, cfg->tx_id);
 #endif
@@ -370,10 +411,21 @@ static const smotor_receive_data_t *motor_dji_can_get_rxdata(const struct device
 static int motor_dji_can_change_tx_feq(const struct device *dev, uint16_t new_feq)
 {
     motor_dji_data_t *data = dev->data;
-    if (data == NULL) {
+    const motor_dji_cfg_t *cfg = dev->config;
+    if (data == NULL || cfg == NULL) {
         LOG_ERR("[dji_motor_err] change Tx feq Invalid arguments");
         return -EINVAL;
     }
+#if defined(CONFIG_CAN_TX_MANAGER)
+    /* 已注册的帧交给 TX 管理器重新排程；同一 tx_id 的电机共用一帧，频率一起变化 */
+    if (data->registered) {
+        int ret = can_tx_manager_set_frequency(cfg->tx_mgr, cfg->tx_id, new_feq);
+        if (ret < 0) {
+            LOG_ERR("[dji_motor_err] TxManager rejected %u Hz: %d", new_feq, ret);
+            return ret;
+        }
+    }
+#endif
     k_spinlock_key_t key = k_spin_lock(&data->lock);
     data->Tx_feq = new_feq;
     k_spin_unlock(&data->lock, key);
@@ -454,6 +506,9 @@ static int motor_dji_can_init(const struct device *dev)
 #endif
 
     data->registered = false;
+#if defined(CONFIG_CAN_TX_MANAGER)
+    data->tx_handle = -1;                   // 注册前写控制量返回 -ENOENT
+#endif
     memset(&data->motor_data, 0, sizeof(data->motor_data));
     data->motor_data.interface_ptr = (void *)cfg;
     data->motor_data.rx_data.valid_mask = 0U;
@@ -64,6 +64,12 @@ typedef struct motor_dji_data_t
 #if defined(CONFIG_CAN_RX_MANAGER)
     int rxmanager_slot_id;                  // CAN RX管理器 槽位ID
 #endif
+#if defined(CONFIG_CAN_TX_MANAGER)
+    int tx_handle;                          // CAN TX管理器 帧句柄，写控制量时免查找
+#endif
+#if defined(CONFIG_CAN_RX_MANAGER_LIVENESS)
+    bool hb_watched;                        // 心跳由 RX 管理器的 liveness 定时器维护，不再轮询
+#endif
 
 #if defined(CONFIG_MOTOR_HEARTBEAT_AUTOCHECK)
     const struct device *dev_self;          // 指向自身设备的指针，用于心跳自动检测
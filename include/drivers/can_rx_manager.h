@@ -8,6 +8,8 @@
 #define CAN_RX_MANAGER_H_
 
 #include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/drivers/can.h>
 
 #ifdef __cplusplus
@@ -16,21 +18,225 @@ extern "C" {
 
 typedef void (*can_rx_handler_t)(const struct can_frame *frame, void *user_data);
 
+/**
+ * @brief Reception metadata captured in the CAN RX interrupt.
+ *
+ * The controller timestamp, if any, stays in frame->timestamp (CONFIG_CAN_RX_TIMESTAMP).
+ */
+struct can_rx_meta {
+    uint32_t rx_cycles; /**< k_cycle_get_32() when the frame reached the manager ISR callback */
+};
+
+/**
+ * @brief RX handler that also receives the arrival time of the frame.
+ *
+ * Register with can_rx_manager_register_ts().
+ */
+typedef void (*can_rx_handler_ts_t)(const struct can_frame *frame, const struct can_rx_meta *meta,
+                                    void *user_data);
+
+/**
+ * @brief Run the handler directly from the CAN RX interrupt instead of the manager RX thread.
+ *
+ * Only for short, ISR-safe handlers (decode a few bytes under a spinlock, no blocking calls).
+ * Frames that match no thread-context listener then never enter the RX queue.
+ */
+#define CAN_RX_LISTENER_ISR BIT(0)
+
+/**
+ * @brief Latest-value delivery: only the newest frame per listener is kept until the RX thread runs.
+ *
+ * The ISR overwrites the listener's mailbox and marks it dirty instead of queueing every frame,
+ * so periodic feedback can never fill the RX queue with stale frames. Requires an exact-ID
+ * filter; overwritten frames are counted (see can_rx_manager_get_coalesced()).
+ */
+#define CAN_RX_LISTENER_MAILBOX BIT(1)
+
+/**
+ * @brief The handler is a can_rx_handler_ts_t. Set by can_rx_manager_register_ts().
+ */
+#define CAN_RX_LISTENER_TIMESTAMP BIT(2)
+
+/**
+ * @brief Priority class of a thread-context listener (CONFIG_CAN_RX_MANAGER_RX_CLASSES).
+ *
+ * Every class has its own RX ring and worker thread; class 0, the default, runs at the
+ * manager's RX thread priority and class n CONFIG_CAN_RX_MANAGER_RX_CLASS_PRIO_STEP x n
+ * levels lower. The ISR queues a frame only to the classes that have a matching listener,
+ * so bulk traffic in a higher class can neither delay nor overflow class 0 feedback. Not
+ * combinable with CAN_RX_LISTENER_ISR or CAN_RX_LISTENER_MAILBOX.
+ */
+#define CAN_RX_LISTENER_CLASS(n) (((uint32_t)(n) & 0x3U) << 4)
+
+/** Class encoded in CAN_RX_LISTENER_* flags */
+#define CAN_RX_LISTENER_CLASS_GET(flags) (((uint32_t)(flags) >> 4) & 0x3U)
+
+/** Number of log2 buckets of a latency histogram */
+#define CAN_RX_STATS_BUCKETS 24
+
+/**
+ * @brief Latency histogram in hardware cycles (k_cycle_get_32() units).
+ *
+ * bucket[i] counts samples in [2^i, 2^(i+1)) cycles; bucket[0] also holds 0 and the
+ * last bucket everything above.
+ */
+struct can_rx_latency_hist {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t bucket[CAN_RX_STATS_BUCKETS];
+};
+
+/**
+ * @brief Receive pipeline latency of one manager (CONFIG_CAN_RX_MANAGER_STATS).
+ */
+struct can_rx_manager_stats {
+    struct can_rx_latency_hist isr;     /**< ISR callback entry -> frame enqueued in the RX ring */
+    struct can_rx_latency_hist queue;   /**< enqueue (or mailbox post) -> dequeue by the RX thread */
+    struct can_rx_latency_hist handler; /**< handler entry -> exit, all listeners */
+};
+
+/**
+ * @brief Traffic counters of one direction, since boot.
+ */
+struct can_bus_traffic {
+    uint64_t frames;
+    uint64_t bits_nominal; /**< bits at the nominal bitrate, stuff bits and interframe space included */
+    uint64_t bits_data;    /**< CAN-FD data-phase bits sent with BRS */
+};
+
+/**
+ * @brief Bus statistics of one manager, RX and TX.
+ *
+ * Rates and load cover the sliding window kept by the manager
+ * (CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICES slices of CONFIG_CAN_RX_MANAGER_BUS_STATS_SLICE_MS).
+ */
+struct can_bus_stats {
+    struct can_bus_traffic rx;
+    struct can_bus_traffic tx;  /**< frames reported by the CAN TX manager */
+    uint32_t window_ms;         /**< span actually covered by the fields below */
+    uint32_t rx_fps;            /**< received frames per second */
+    uint32_t tx_fps;            /**< transmitted frames per second */
+    uint32_t busy_us;           /**< bus time occupied by RX and TX frames in the window */
+    float load;                 /**< busy_us / window_ms in percent, devicetree bitrates */
+    uint32_t id_overflow;       /**< frames whose ID found no room in the per-ID table */
+};
+
+/**
+ * @brief Frame rate of one CAN ID over the sliding window.
+ */
+struct can_bus_id_rate {
+    uint32_t id;
+    bool ext;        /**< extended (29-bit) identifier */
+    bool tx;         /**< transmitted by this node rather than received */
+    uint32_t frames; /**< frames in the window */
+    uint32_t rate_hz;
+};
+
+/**
+ * @brief RX ring occupancy of a manager (CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR).
+ *
+ * Sizes are in bytes: a classic frame record takes the same room whatever the ring
+ * length, a CAN-FD record more. With listener classes the values cover the rings of all
+ * classes together.
+ */
+struct can_rx_ring_stats {
+    uint32_t size;          /**< ring size */
+    uint32_t used;          /**< bytes waiting for the RX thread now */
+    uint32_t high_water;    /**< peak of used since the previous read */
+    uint32_t queued;        /**< frames put into a ring since init, once per class */
+    uint32_t dropped;       /**< frames lost because a ring was full since init */
+};
+
+/**
+ * @brief Capture stream layout (CONFIG_CAN_RX_MANAGER_CAPTURE).
+ *
+ * can_rx_manager_capture_read() produces a pcap stream with link type
+ * LINKTYPE_CAN_SOCKETCAN: a file header, then one record header plus a SocketCAN
+ * frame header and the received payload per frame. Wireshark and tshark read it
+ * directly; can_rx_manager_replay() takes the same bytes back.
+ */
+#define CAN_RX_CAPTURE_FILE_HDR 24
+#define CAN_RX_CAPTURE_REC_MAX  (16 + 8 + 64)
+
+struct can_rx_capture_status {
+    bool running;
+    uint32_t frames;    /**< frames recorded since the last start */
+    uint32_t dropped;   /**< frames lost because the capture ring was full */
+    uint32_t pending;   /**< bytes waiting to be read */
+};
+
+/**
+ * @brief Liveness state of a watched listener (CONFIG_CAN_RX_MANAGER_LIVENESS).
+ */
+enum can_rx_liveness {
+    CAN_RX_LIVE_UNKNOWN = 0,    /**< watched, no frame received yet */
+    CAN_RX_LIVE_ONLINE,         /**< frames arrive within the learned deadline */
+    CAN_RX_LIVE_LATE,           /**< learned deadline missed, offline timeout not reached yet */
+    CAN_RX_LIVE_OFFLINE,        /**< no frame for the offline timeout */
+};
+
+/**
+ * @brief Called on every liveness state change of a watched listener.
+ *
+ * Runs in interrupt context (manager timer, CAN RX ISR) or in the manager RX thread for
+ * thread-context listeners; must not block.
+ */
+typedef void (*can_rx_liveness_cb_t)(int listener_id, enum can_rx_liveness state, void *user_data);
+
+/**
+ * @brief Arrival statistics of a watched listener, learned from the ISR arrival times.
+ */
+struct can_rx_liveness_stats {
+    enum can_rx_liveness state;
+    uint32_t frames;        /**< frames received since the watch started */
+    uint32_t period_us;     /**< learned mean frame interval, 0 while still learning */
+    uint32_t jitter_us;     /**< mean deviation of the interval from period_us */
+    uint32_t min_us;        /**< shortest interval seen */
+    uint32_t max_us;        /**< longest interval seen */
+    uint32_t age_us;        /**< time since the newest frame (or the watch start) */
+    uint32_t late;          /**< times the learned deadline was missed */
+    uint32_t offline;       /**< times the listener went offline */
+};
+
+/**
+ * @brief Error state history and bus-off recovery of a manager's bus
+ *        (CONFIG_CAN_RX_MANAGER_BUS_RECOVERY).
+ */
+struct can_bus_health {
+    enum can_state state;               /**< current controller state */
+    struct can_bus_err_cnt err_cnt;     /**< current TX/RX error counters */
+    uint32_t error_passive;             /**< times the controller entered error-passive */
+    uint32_t bus_off;                   /**< times the controller went bus-off */
+    uint32_t restarts;                  /**< controller restarts made by the manager */
+    uint32_t recoveries;                /**< bus-off periods that ended */
+    uint64_t error_passive_us;          /**< total time spent error-passive, including now */
+    uint64_t bus_off_us;                /**< total time spent bus-off, including now */
+    uint32_t last_recovery_us;          /**< duration of the last bus-off period */
+    uint32_t max_recovery_us;           /**< longest bus-off period */
+    uint32_t backoff_ms;                /**< delay of the next restart, 0 while the bus is up */
+};
+
 /**
  * @brief Register a software RX handler inside a CAN RX manager.
  * @param mgr      CAN RX manager device.
  * @param filter   CAN filter used for software matching (standard/extended is controlled by flags).
- * @param handler  Called in manager RX thread context.
+ * @param handler  Called in manager RX thread context (or ISR context with CAN_RX_LISTENER_ISR).
  * @param user_data Opaque pointer passed to handler.
+ * @param flags    CAN_RX_LISTENER_* flags.
  *
  * @retval >=0 Listener ID (can be used for unregister).
  */
 typedef int (*can_rx_manager_api_register)(const struct device *mgr, const struct can_filter *filter,
-                                           can_rx_handler_t handler, void *user_data);
+                                           can_rx_handler_t handler, void *user_data, uint32_t flags);
 
 /**
  * @brief Unregister a previously registered listener.
  *
+ * Safe while frames are being received. On return the handler is no longer called, so its
+ * user_data may be freed (except when unregistering from inside that handler).
+ *
  * @param mgr CAN RX manager device.
  * @param listener_id Listener ID returned by can_rx_manager_api_register().
  * @retval 0 on success.
@@ -38,20 +244,180 @@ typedef int (*can_rx_manager_api_register)(const struct device *mgr, const struc
 typedef int (*can_rx_manager_api_unregister)(const struct device *mgr, int listener_id);
 
 /**
- * @brief Calculate current CAN bus load (percentage) over the interval since last call.
+ * @brief Calculate the CAN bus load (percentage) over the manager's sliding window, without side effects.
  * @param mgr CAN RX manager device
- * @param nominal_bitrate_bps Bitrate used for arbitration/CRC/control (bps)
- * @param data_bitrate_bps Bitrate used for FD data phase when BRS is set (bps). If 0, FD data is assumed to use nominal rate.
+ * @param nominal_bitrate_bps Bitrate used for arbitration/CRC/control (bps); 0 uses the devicetree bitrate.
+ * @param data_bitrate_bps Bitrate used for FD data phase when BRS is set (bps); 0 uses the devicetree bitrate-data or nominal rate.
  * @return load percentage in range [0.0 .. 100.0], negative on error.
  */
 typedef float (*can_rx_manager_api_calculate_load)(const struct device *mgr, uint32_t nominal_bitrate_bps, uint32_t data_bitrate_bps);
 
+/**
+ * @brief Read the number of frames coalesced (overwritten) in mailboxes.
+ * @param mgr CAN RX manager device
+ * @param listener_id Mailbox listener ID, or -1 for the manager total
+ * @param count Output counter
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_get_coalesced)(const struct device *mgr, int listener_id, uint32_t *count);
+
+/**
+ * @brief Copy the latency histograms of a manager or one listener.
+ * @param mgr CAN RX manager device
+ * @param listener_id Listener ID (only stats->handler is filled), or -1 for the manager
+ * @param stats Output histograms
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_get_stats)(const struct device *mgr, int listener_id,
+                                            struct can_rx_manager_stats *stats);
+
+/**
+ * @brief Clear all latency histograms of a manager and its listeners.
+ * @param mgr CAN RX manager device
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_reset_stats)(const struct device *mgr);
+
+/**
+ * @brief Read the bus statistics without modifying them.
+ * @param mgr CAN RX manager device
+ * @param stats Output statistics
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_get_bus_stats)(const struct device *mgr, struct can_bus_stats *stats);
+
+/**
+ * @brief Read the per-ID frame rates.
+ * @param mgr CAN RX manager device
+ * @param rates Output array
+ * @param max Capacity of rates
+ * @retval >=0 Number of entries written.
+ */
+typedef int (*can_rx_manager_api_get_id_rates)(const struct device *mgr, struct can_bus_id_rate *rates,
+                                               size_t max);
+
+/**
+ * @brief Account a frame transmitted on the manager's bus.
+ * @param mgr CAN RX manager device
+ * @param frame Transmitted frame
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_account_tx)(const struct device *mgr, const struct can_frame *frame);
+
+/**
+ * @brief Read the RX ring occupancy and counters.
+ * @param mgr CAN RX manager device
+ * @param stats Output statistics
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_get_ring_stats)(const struct device *mgr, struct can_rx_ring_stats *stats);
+
+/**
+ * @brief Start (running=true) or stop recording received frames.
+ * @param mgr CAN RX manager device
+ * @param running true to clear the capture ring and start, false to stop
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_capture_ctrl)(const struct device *mgr, bool running);
+
+/**
+ * @brief Move whole records out of the capture ring.
+ * @param mgr CAN RX manager device
+ * @param buf Output buffer
+ * @param len Size of buf
+ * @retval >=0 Number of bytes written.
+ */
+typedef int (*can_rx_manager_api_capture_read)(const struct device *mgr, uint8_t *buf, size_t len);
+
+/**
+ * @brief Read the capture state and counters.
+ * @param mgr CAN RX manager device
+ * @param status Output status
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_capture_status)(const struct device *mgr,
+                                                 struct can_rx_capture_status *status);
+
+/**
+ * @brief Feed a recorded trace through the dispatch path.
+ * @param mgr CAN RX manager device
+ * @param trace Capture stream
+ * @param len Length of trace in bytes
+ * @param speed_pct Playback speed in percent of the recorded timing, 0 for no pacing
+ * @retval >=0 Number of frames injected.
+ */
+typedef int (*can_rx_manager_api_replay)(const struct device *mgr, const uint8_t *trace, size_t len,
+                                         uint32_t speed_pct);
+
+/**
+ * @brief Start watching the frame arrivals of a listener.
+ * @param mgr CAN RX manager device
+ * @param listener_id Listener ID
+ * @param timeout_ms Offline timeout, 0 to derive it from the learned period
+ * @param cb State change callback, may be NULL
+ * @param user_data Opaque pointer passed to cb
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_watch)(const struct device *mgr, int listener_id, uint32_t timeout_ms,
+                                        can_rx_liveness_cb_t cb, void *user_data);
+
+/**
+ * @brief Read the arrival statistics of a watched listener.
+ * @param mgr CAN RX manager device
+ * @param listener_id Listener ID
+ * @param stats Output statistics
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_get_liveness)(const struct device *mgr, int listener_id,
+                                               struct can_rx_liveness_stats *stats);
+
+/**
+ * @brief Read the error state history of the manager's bus.
+ * @param mgr CAN RX manager device
+ * @param health Output statistics
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_get_bus_health)(const struct device *mgr, struct can_bus_health *health);
+
+/**
+ * @brief Read the controller state as last reported to the manager.
+ * @param mgr CAN RX manager device
+ * @retval >=0 enum can_state.
+ */
+typedef int (*can_rx_manager_api_get_bus_state)(const struct device *mgr);
+
+/**
+ * @brief Set the callback the manager forwards controller state changes to.
+ * @param mgr CAN RX manager device
+ * @param cb Callback, NULL to remove it
+ * @param user_data Opaque pointer passed to cb
+ * @retval 0 on success.
+ */
+typedef int (*can_rx_manager_api_set_state_cb)(const struct device *mgr, can_state_change_callback_t cb,
+                                               void *user_data);
+
 
 struct can_rx_manager_api
 {
     can_rx_manager_api_register register_listener;
     can_rx_manager_api_unregister unregister_listener;
     can_rx_manager_api_calculate_load calculate_load;
+    can_rx_manager_api_get_coalesced get_coalesced;
+    can_rx_manager_api_get_stats get_stats;
+    can_rx_manager_api_reset_stats reset_stats;
+    can_rx_manager_api_get_bus_stats get_bus_stats;
+    can_rx_manager_api_get_id_rates get_id_rates;
+    can_rx_manager_api_account_tx account_tx;
+    can_rx_manager_api_get_ring_stats get_ring_stats;
+    can_rx_manager_api_capture_ctrl capture_ctrl;
+    can_rx_manager_api_capture_read capture_read;
+    can_rx_manager_api_capture_status capture_status;
+    can_rx_manager_api_replay replay;
+    can_rx_manager_api_watch watch;
+    can_rx_manager_api_get_liveness get_liveness;
+    can_rx_manager_api_get_bus_health get_bus_health;
+    can_rx_manager_api_get_bus_state get_bus_state;
+    can_rx_manager_api_set_state_cb set_state_cb;
 };
 
 /**
@@ -69,7 +435,69 @@ static inline int can_rx_manager_register(const struct device *mgr, const struct
     if (api->register_listener == NULL) {
         return -ENOSYS;
     }
-    return api->register_listener(mgr, filter, handler, user_data);
+    return api->register_listener(mgr, filter, handler, user_data, 0U);
+}
+
+/**
+ * @brief Register a software RX handler with CAN_RX_LISTENER_* flags.
+ * @param mgr      CAN RX manager device.
+ * @param filter   CAN filter used for software matching (standard/extended is controlled by flags).
+ * @param handler  Called in manager RX thread context, or in ISR context with CAN_RX_LISTENER_ISR.
+ * @param user_data Opaque pointer passed to handler.
+ * @param flags    CAN_RX_LISTENER_* flags.
+ * @return int     Listener ID on success, negative error code on failure; -ENOSPC with
+ *                 CONFIG_CAN_RX_MANAGER_HW_FILTER when the controller has no filter element
+ *                 for the ID type of @p filter
+ */
+static inline int can_rx_manager_register_flags(const struct device *mgr, const struct can_filter *filter,
+                                                can_rx_handler_t handler, void *user_data, uint32_t flags)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->register_listener == NULL) {
+        return -ENOSYS;
+    }
+    return api->register_listener(mgr, filter, handler, user_data, flags);
+}
+
+/**
+ * @brief Register an RX handler that receives the ISR arrival time of each frame.
+ *
+ * Use this instead of sampling the time in the handler: thread-context and mailbox
+ * handlers run later than the frame arrived.
+ *
+ * @param mgr      CAN RX manager device.
+ * @param filter   CAN filter used for software matching (standard/extended is controlled by flags).
+ * @param handler  Called like a can_rx_handler_t, plus the reception metadata.
+ * @param user_data Opaque pointer passed to handler.
+ * @param flags    CAN_RX_LISTENER_* flags.
+ * @return int     Listener ID on success, negative error code on failure; -ENOSPC with
+ *                 CONFIG_CAN_RX_MANAGER_HW_FILTER when the controller has no filter element
+ *                 for the ID type of @p filter
+ */
+static inline int can_rx_manager_register_ts(const struct device *mgr, const struct can_filter *filter,
+                                             can_rx_handler_ts_t handler, void *user_data, uint32_t flags)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->register_listener == NULL) {
+        return -ENOSYS;
+    }
+    /* passed through the generic slot; the manager calls it back with its real type */
+    return api->register_listener(mgr, filter, (can_rx_handler_t)(void (*)(void))handler, user_data,
+                                  flags | CAN_RX_LISTENER_TIMESTAMP);
+}
+
+/**
+ * @brief Convert a frame arrival time to the k_uptime_get() time base.
+ *
+ * Valid while the frame is younger than one k_cycle_get_32() wrap.
+ *
+ * @param meta Reception metadata passed to a can_rx_handler_ts_t
+ * @return int64_t Uptime in milliseconds at which the frame arrived
+ */
+static inline int64_t can_rx_meta_uptime_ms(const struct can_rx_meta *meta)
+{
+    uint32_t age = k_cycle_get_32() - meta->rx_cycles;
+    return k_uptime_get() - (int64_t)k_cyc_to_ms_floor32(age);
 }
 
 /**
@@ -89,11 +517,15 @@ static inline int can_rx_manager_unregister(const struct device *mgr, int listen
 }
 
 /**
- * @brief Calculate the CAN bus load percentage over the interval since the last call.
+ * @brief Calculate the CAN bus load percentage (RX and TX) over the manager's sliding window.
+ *
+ * Has no side effects, any number of callers may poll it. With CONFIG_CAN_RX_MANAGER_HW_FILTER
+ * (the default) the controller drops frames no listener wants, so the RX side only counts the
+ * accepted frames and the result is a lower bound of the real bus load.
  *
  * @param mgr                CAN RX manager device
- * @param nominal_bitrate_bps Nominal (arbitration) bitrate in bps
- * @param data_bitrate_bps   FD data-phase bitrate in bps; 0 means use nominal rate (classic CAN)
+ * @param nominal_bitrate_bps Nominal (arbitration) bitrate in bps; 0 uses the devicetree bitrate
+ * @param data_bitrate_bps   FD data-phase bitrate in bps; 0 uses the devicetree bitrate-data or nominal rate
  * @return float             Load percentage [0.0 .. 100.0], negative value on error
  */
 static inline float can_rx_manager_calculate_load(const struct device *mgr, uint32_t nominal_bitrate_bps, uint32_t data_bitrate_bps)
@@ -105,6 +537,385 @@ static inline float can_rx_manager_calculate_load(const struct device *mgr, uint
     return api->calculate_load(mgr, nominal_bitrate_bps, data_bitrate_bps);
 }
 
+/**
+ * @brief Read how many frames were overwritten in mailboxes before the RX thread consumed them.
+ *
+ * @param mgr         CAN RX manager device
+ * @param listener_id Listener registered with CAN_RX_LISTENER_MAILBOX, or -1 for the manager total
+ * @param count       Output counter
+ * @return int        0 on success, negative error code on failure
+ */
+static inline int can_rx_manager_get_coalesced(const struct device *mgr, int listener_id, uint32_t *count)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->get_coalesced == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_coalesced(mgr, listener_id, count);
+}
+
+/**
+ * @brief Read the receive pipeline latency histograms.
+ *
+ * Only available with CONFIG_CAN_RX_MANAGER_STATS; per-listener histograms additionally
+ * need CONFIG_CAN_RX_MANAGER_STATS_PER_LISTENER.
+ *
+ * @param mgr         CAN RX manager device
+ * @param listener_id Listener ID for its handler histogram, or -1 for the manager stages
+ * @param stats       Output histograms
+ * @return int        0 on success, -ENOSYS if statistics are disabled, negative error code on failure
+ */
+static inline int can_rx_manager_get_stats(const struct device *mgr, int listener_id,
+                                           struct can_rx_manager_stats *stats)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->get_stats == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_stats(mgr, listener_id, stats);
+}
+
+/**
+ * @brief Clear the latency histograms of a manager and all its listeners.
+ *
+ * @param mgr CAN RX manager device
+ * @return int 0 on success, -ENOSYS if statistics are disabled
+ */
+static inline int can_rx_manager_reset_stats(const struct device *mgr)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->reset_stats == NULL) {
+        return -ENOSYS;
+    }
+    return api->reset_stats(mgr);
+}
+
+/**
+ * @brief Read frame/bit counters, frame rates and load of the manager's bus.
+ *
+ * With CONFIG_CAN_RX_MANAGER_HW_FILTER (the default) the RX counters, rates and load only
+ * cover the frames the acceptance filters let through, not all traffic on the bus.
+ *
+ * @param mgr   CAN RX manager device
+ * @param stats Output statistics
+ * @return int  0 on success, negative error code on failure
+ */
+static inline int can_rx_manager_get_bus_stats(const struct device *mgr, struct can_bus_stats *stats)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->get_bus_stats == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_bus_stats(mgr, stats);
+}
+
+/**
+ * @brief Read the frame rate of every CAN ID seen on the bus (CONFIG_CAN_RX_MANAGER_BUS_STATS_IDS).
+ *
+ * @param mgr   CAN RX manager device
+ * @param rates Output array
+ * @param max   Capacity of rates
+ * @return int  Number of entries written, negative error code on failure
+ */
+static inline int can_rx_manager_get_id_rates(const struct device *mgr, struct can_bus_id_rate *rates, size_t max)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->get_id_rates == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_id_rates(mgr, rates, max);
+}
+
+/**
+ * @brief Report a frame this node put on the manager's bus, for the TX side of the statistics.
+ *
+ * Called by the CAN TX manager; other direct can_send() users may call it as well.
+ *
+ * @param mgr   CAN RX manager device of the bus
+ * @param frame Transmitted frame
+ * @return int  0 on success, negative error code on failure
+ */
+static inline int can_rx_manager_account_tx(const struct device *mgr, const struct can_frame *frame)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->account_tx == NULL) {
+        return -ENOSYS;
+    }
+    return api->account_tx(mgr, frame);
+}
+
+/**
+ * @brief Read the RX ring occupancy, its high-water mark and the queued/dropped counters.
+ *
+ * The high-water mark restarts from zero after every call, so successive calls give the
+ * peak of each interval.
+ *
+ * @param mgr   CAN RX manager device
+ * @param stats Output statistics
+ * @return int  0 on success, -ENOSYS without CONFIG_CAN_RX_MANAGER_MSGQ_MONITOR
+ */
+static inline int can_rx_manager_get_ring_stats(const struct device *mgr, struct can_rx_ring_stats *stats)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->get_ring_stats == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_ring_stats(mgr, stats);
+}
+
+/**
+ * @brief Clear the capture ring and start recording every received frame.
+ *
+ * @param mgr CAN RX manager device
+ * @return int 0 on success, -ENOSYS without CONFIG_CAN_RX_MANAGER_CAPTURE
+ */
+static inline int can_rx_manager_capture_start(const struct device *mgr)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->capture_ctrl == NULL) {
+        return -ENOSYS;
+    }
+    return api->capture_ctrl(mgr, true);
+}
+
+/**
+ * @brief Stop recording; frames already captured can still be read.
+ *
+ * @param mgr CAN RX manager device
+ * @return int 0 on success, negative error code on failure
+ */
+static inline int can_rx_manager_capture_stop(const struct device *mgr)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->capture_ctrl == NULL) {
+        return -ENOSYS;
+    }
+    return api->capture_ctrl(mgr, false);
+}
+
+/**
+ * @brief Drain captured frames as a pcap (LINKTYPE_CAN_SOCKETCAN) byte stream.
+ *
+ * The first read after can_rx_manager_capture_start() begins with the pcap file
+ * header. Only whole records are returned, so concatenating the reads gives a valid
+ * file; a buffer of CAN_RX_CAPTURE_REC_MAX bytes or more always makes progress.
+ * Meant for a single reader thread, e.g. one pushing the stream to RTT or USB.
+ *
+ * @param mgr CAN RX manager device
+ * @param buf Output buffer
+ * @param len Size of buf
+ * @return int Bytes written (0 if nothing is pending), negative error code on failure
+ */
+static inline int can_rx_manager_capture_read(const struct device *mgr, uint8_t *buf, size_t len)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->capture_read == NULL) {
+        return -ENOSYS;
+    }
+    return api->capture_read(mgr, buf, len);
+}
+
+/**
+ * @brief Read the capture state and counters.
+ *
+ * @param mgr    CAN RX manager device
+ * @param status Output status
+ * @return int   0 on success, negative error code on failure
+ */
+static inline int can_rx_manager_capture_status(const struct device *mgr, struct can_rx_capture_status *status)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->capture_status == NULL) {
+        return -ENOSYS;
+    }
+    return api->capture_status(mgr, status);
+}
+
+/**
+ * @brief Inject a recorded trace into the manager as if the frames were received.
+ *
+ * Frames run through the same dispatch path as the CAN ISR (listeners, mailboxes, RX
+ * ring and bus statistics) but are not captured again. With @p speed_pct > 0 the
+ * recorded inter-frame gaps are reproduced, scaled by 100 / speed_pct; with 0 frames are
+ * injected as fast as the RX thread consumes them, without ever overflowing the ring.
+ * Blocks until the whole trace is played. Error frames and frames this build cannot
+ * represent (CAN-FD without CONFIG_CAN_FD_MODE) are skipped.
+ *
+ * @param mgr       CAN RX manager device
+ * @param trace     Bytes produced by can_rx_manager_capture_read(), file header optional
+ * @param len       Length of trace
+ * @param speed_pct Playback speed in percent, 0 for unpaced
+ * @return int      Frames injected, negative error code on a malformed trace
+ */
+static inline int can_rx_manager_replay(const struct device *mgr, const uint8_t *trace, size_t len,
+                                        uint32_t speed_pct)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->replay == NULL) {
+        return -ENOSYS;
+    }
+    return api->replay(mgr, trace, len, speed_pct);
+}
+
+/**
+ * @brief Watch a listener for late and missing frames.
+ *
+ * The manager learns the period and jitter of the listener's frames from their ISR arrival
+ * times. Once CONFIG_CAN_RX_MANAGER_LIVENESS_LEARN intervals are seen, a frame later than
+ * CONFIG_CAN_RX_MANAGER_LIVENESS_LATE_PERIODS periods plus four times the jitter reports
+ * CAN_RX_LIVE_LATE; no frame for @p timeout_ms (or, with 0,
+ * CONFIG_CAN_RX_MANAGER_LIVENESS_OFFLINE_PERIODS learned periods) reports
+ * CAN_RX_LIVE_OFFLINE, also when the first frame never comes. The next frame reports
+ * CAN_RX_LIVE_ONLINE. All deadlines of a manager share one timer.
+ *
+ * Calling it again restarts learning with the new parameters; the watch ends when the
+ * listener is unregistered.
+ *
+ * @param mgr         CAN RX manager device
+ * @param listener_id Listener ID returned by can_rx_manager_register()
+ * @param timeout_ms  Offline timeout in milliseconds, 0 to use the learned period
+ * @param cb          State change callback (see can_rx_liveness_cb_t), NULL for statistics only
+ * @param user_data   Opaque pointer passed to cb
+ * @return int 0 on success, -ENOSPC when all CONFIG_CAN_RX_MANAGER_LIVENESS_NUM trackers
+ *         are in use, -ERANGE if the timeout exceeds the cycle counter range,
+ *         -ENOSYS without CONFIG_CAN_RX_MANAGER_LIVENESS
+ */
+static inline int can_rx_manager_watch(const struct device *mgr, int listener_id, uint32_t timeout_ms,
+                                       can_rx_liveness_cb_t cb, void *user_data)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->watch == NULL) {
+        return -ENOSYS;
+    }
+    return api->watch(mgr, listener_id, timeout_ms, cb, user_data);
+}
+
+/**
+ * @brief Read the learned period, jitter and liveness counters of a watched listener.
+ *
+ * @param mgr         CAN RX manager device
+ * @param listener_id Watched listener ID
+ * @param stats       Output statistics
+ * @return int 0 on success, -ENOENT if the listener is not watched
+ */
+static inline int can_rx_manager_get_liveness(const struct device *mgr, int listener_id,
+                                              struct can_rx_liveness_stats *stats)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->get_liveness == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_liveness(mgr, listener_id, stats);
+}
+
+/**
+ * @brief Read the error-passive/bus-off history and recovery latency of the manager's bus.
+ *
+ * The manager owns the state change callback of its controller. In CAN_MODE_MANUAL_RECOVERY
+ * it calls can_recover() CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_BACKOFF_MIN_MS after bus-off (at
+ * least the 128 x 11 recessive bits the recovery needs). Otherwise the controller is left to
+ * recover by itself and only restarted if it is still bus-off after
+ * CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_GRACE_MS. Either way the delay doubles up to
+ * CONFIG_CAN_RX_MANAGER_BUS_RECOVERY_BACKOFF_MAX_MS while the bus stays down. A controller
+ * stopped by the application is left alone until it goes bus-off again.
+ *
+ * @param mgr    CAN RX manager device
+ * @param health Output statistics
+ * @return int 0 on success, -ENOSYS without CONFIG_CAN_RX_MANAGER_BUS_RECOVERY
+ */
+static inline int can_rx_manager_get_bus_health(const struct device *mgr, struct can_bus_health *health)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->get_bus_health == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_bus_health(mgr, health);
+}
+
+/**
+ * @brief Read the controller state as last reported to the manager.
+ *
+ * Cheap enough for every transmit: no driver call, just the state the manager tracks.
+ * Controller stops requested by software are not tracked.
+ *
+ * @param mgr CAN RX manager device
+ * @return int enum can_state on success, -ENOSYS without CONFIG_CAN_RX_MANAGER_BUS_RECOVERY
+ */
+static inline int can_rx_manager_get_bus_state(const struct device *mgr)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->get_bus_state == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_bus_state(mgr);
+}
+
+/**
+ * @brief Receive the controller state changes of the manager's bus.
+ *
+ * Use this instead of can_set_state_change_callback(), which would replace the callback
+ * the manager recovers the bus with. Called in interrupt context after the manager has
+ * accounted the change.
+ *
+ * @param mgr       CAN RX manager device
+ * @param cb        Callback, NULL to remove it
+ * @param user_data Opaque pointer passed to cb
+ * @return int 0 on success, -ENOSYS without CONFIG_CAN_RX_MANAGER_BUS_RECOVERY
+ */
+static inline int can_rx_manager_set_state_callback(const struct device *mgr, can_state_change_callback_t cb,
+                                                    void *user_data)
+{
+    const struct can_rx_manager_api *api = (const struct can_rx_manager_api *)mgr->api;
+    if (api->set_state_cb == NULL) {
+        return -ENOSYS;
+    }
+    return api->set_state_cb(mgr, cb, user_data);
+}
+
+/**
+ * @brief Find the CAN RX manager attached to a CAN controller.
+ *
+ * @param can_dev CAN controller device
+ * @return const struct device* Manager device, or NULL if the bus has none
+ */
+const struct device *can_rx_manager_get_by_bus(const struct device *can_dev);
+
+/**
+ * @brief Bits a frame occupies on the bus, stuffing and interframe space included.
+ *
+ * The figure the bus statistics account for; the CAN TX manager plans its schedule with it.
+ *
+ * @param frame      CAN frame
+ * @param nominal    Output: bits at the nominal bitrate
+ * @param data_phase Output: bits at the data bitrate (CAN-FD with BRS only, else 0)
+ */
+void can_rx_manager_frame_bits(const struct can_frame *frame, uint32_t *nominal, uint32_t *data_phase);
+
+/**
+ * @brief Estimate a percentile of a latency histogram.
+ *
+ * @param hist     Histogram
+ * @param permille Percentile in 1/1000 (990 for p99)
+ * @return uint32_t Upper bound in cycles of the bucket holding the percentile, clamped to max
+ */
+static inline uint32_t can_rx_latency_percentile(const struct can_rx_latency_hist *hist, uint32_t permille)
+{
+    if (hist->count == 0U) {
+        return 0U;
+    }
+    uint64_t rank = ((uint64_t)hist->count * permille + 999U) / 1000U;
+    uint64_t seen = 0U;
+    for (int i = 0; i < CAN_RX_STATS_BUCKETS; i++) {
+        seen += hist->bucket[i];
+        if (seen >= rank) {
+            if (i == CAN_RX_STATS_BUCKETS - 1) {
+                break;  /* open-ended last bucket */
+            }
+            return MIN((1U << (i + 1)) - 1U, hist->max);
+        }
+    }
+    return hist->max;
+}
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,27 @@ extern "C"
 
 typedef int (*tx_fillbuffer_cb_t)(struct can_frame *frame, void *user_data);
 
+/**
+ * @brief Per-tick load of the periodic schedule of a TX manager.
+ *
+ * Periodic frames get their phase at registration, so frames of the same period are spread
+ * over their cycle instead of all being queued on one tick.
+ */
+struct can_tx_schedule_stats {
+    uint16_t periodic;          /**< periodic frames scheduled */
+    uint16_t peak_frames;       /**< most frames due on one tick */
+    uint32_t peak_bits;         /**< most bus bits due on one tick, counted like the RX manager bus statistics */
+    uint32_t peak_permille;     /**< peak_bits in 1/1000 of what the bus carries in one tick */
+    uint32_t plan_ticks;        /**< ticks the peak was searched over (one hyperperiod, capped) */
+    uint32_t tick_us;           /**< scheduler tick */
+    uint16_t sent_peak;         /**< most frames actually sent on one tick since the last read */
+    uint32_t sent;              /**< periodic frames sent since boot */
+    uint32_t unchanged;         /**< periodic sends skipped since boot, payload unchanged (send-on-change) */
+    uint8_t governor_shift;     /**< low-priority rates are currently divided by 1 << governor_shift */
+    uint32_t sync_sent;         /**< feedback-synchronized frames sent after their feedback */
+    uint32_t sync_timeouts;     /**< feedback-synchronized frames sent because feedback was missing */
+};
+
 /**
   * @brief Register a software TX handler inside a CAN TX manager.
  */
@@ -26,11 +47,44 @@ typedef int (*can_tx_manager_api_unregister)(const struct device *mgr, const uin
 
 typedef int (*can_tx_manager_api_send)(const struct device *mgr, k_timeout_t timeout, can_tx_callback_t callback, uint16_t tx_id, void *user_data);
 
+typedef int (*can_tx_manager_api_write)(const struct device *mgr, uint16_t tx_id, uint8_t offset, const uint8_t *payload, uint8_t len);
+
+typedef int (*can_tx_manager_api_send_handle)(const struct device *mgr, k_timeout_t timeout, can_tx_callback_t callback, int handle, void *user_data);
+
+typedef int (*can_tx_manager_api_write_handle)(const struct device *mgr, int handle, uint8_t offset, const uint8_t *payload, uint8_t len);
+
+typedef int (*can_tx_manager_api_get_schedule)(const struct device *mgr, struct can_tx_schedule_stats *stats);
+
+typedef int (*can_tx_manager_api_set_on_change)(const struct device *mgr, uint16_t tx_id, uint32_t max_age_ms);
+
+typedef int (*can_tx_manager_api_set_frequency)(const struct device *mgr, uint16_t tx_id, uint16_t frequency);
+
+typedef int (*can_tx_manager_api_set_low_priority)(const struct device *mgr, uint16_t tx_id, uint16_t min_frequency);
+
+typedef int (*can_tx_manager_api_set_sync)(const struct device *mgr, uint16_t tx_id, const uint32_t *rx_ids, uint8_t rx_num, uint32_t offset_us, uint32_t timeout_us);
+
+typedef int (*can_tx_manager_api_reserve)(const struct device *mgr, int handle, struct can_frame **frame);
+
+typedef int (*can_tx_manager_api_commit)(const struct device *mgr, struct can_frame *frame, k_timeout_t timeout, can_tx_callback_t callback, void *user_data);
+
+typedef int (*can_tx_manager_api_release)(const struct device *mgr, struct can_frame *frame);
+
 struct can_tx_manager_api
 {
     can_tx_manager_api_register register_sender;
     can_tx_manager_api_unregister unregister_sender;
     can_tx_manager_api_send send_frame;
+    can_tx_manager_api_write write_data;
+    can_tx_manager_api_send_handle send_handle;
+    can_tx_manager_api_write_handle write_handle;
+    can_tx_manager_api_get_schedule get_schedule;
+    can_tx_manager_api_set_on_change set_on_change;
+    can_tx_manager_api_set_frequency set_frequency;
+    can_tx_manager_api_set_low_priority set_low_priority;
+    can_tx_manager_api_set_sync set_sync;
+    can_tx_manager_api_reserve reserve;
+    can_tx_manager_api_commit commit;
+    can_tx_manager_api_release release;
 };
 
 /**
@@ -41,10 +95,16 @@ struct can_tx_manager_api
  * @param rx_id Reserved for future use (receive ID)
  * @param dlc Data length code for the frame (usually 8)
  * @param flags CAN frame flags (0 for standard frame)
- * @param frequency Transmit rate in Hz (0 means event-driven)
- * @param fill_buffer_cb Callback invoked to populate the frame payload
+ * @param frequency Transmit rate in Hz (0 means event-driven), at most
+ *                  1000000 / CONFIG_CAN_TX_MANAGER_TICK_US; rounded to whole ticks
+ * @param fill_buffer_cb Callback invoked to populate the frame payload, or NULL to
+ *                       write the payload with can_tx_manager_write(). Runs in the TX thread
+ *                       under a lock of this frame only; it must not register or unregister
+ *                       senders of the same tx_id
  * @param user_data Opaque pointer passed to the callback
- * @return int
+ * @return int Frame handle (>= 0) for can_tx_manager_send_handle() and
+ *         can_tx_manager_write_handle(), shared by all senders of tx_id; negative error code
+ *         on failure
  */
 static inline int can_tx_manager_register(const struct device *mgr, uint16_t tx_id, uint16_t rx_id, uint8_t dlc, uint8_t flags, uint16_t frequency, tx_fillbuffer_cb_t fill_buffer_cb, void *user_data)
 {
@@ -80,7 +140,8 @@ static inline int can_tx_manager_unregister(const struct device *mgr, const uint
  * @param callback Callback function to be called upon completion
  * @param tx_id CAN identifier for outgoing frames
  * @param user_data Opaque pointer passed to the callback
- * @return int
+ * @return int 0 on success, -ENETUNREACH while the bus is off (the RX manager of the bus
+ *         recovers it with CONFIG_CAN_RX_MANAGER_BUS_RECOVERY)
  */
 static inline int can_tx_manager_send(const struct device *mgr, k_timeout_t timeout, can_tx_callback_t callback, uint16_t tx_id, void *user_data)
 {
@@ -92,6 +153,249 @@ static inline int can_tx_manager_send(const struct device *mgr, k_timeout_t time
 }
 
 
+/**
+ * @brief Write part of the payload of a registered frame.
+ *
+ * The bytes are merged into the latest frame and published as a whole through a per-frame
+ * double buffer: the periodic thread and can_tx_manager_send() copy the frame without
+ * locking, so writers never block the TX schedule and the schedule never blocks writers.
+ * Frames of senders registered without a fill callback only take their payload from here.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame
+ * @param offset First payload byte to write
+ * @param payload Bytes to write
+ * @param len Number of bytes
+ * @return int 0 on success, -ENOENT if tx_id is not registered, -EINVAL if the bytes do not
+ *         fit the frame's DLC
+ */
+static inline int can_tx_manager_write(const struct device *mgr, uint16_t tx_id, uint8_t offset, const uint8_t *payload, uint8_t len)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->write_data == NULL) {
+        return -ENOSYS;
+    }
+    return api->write_data(mgr, tx_id, offset, payload, len);
+}
+
+/**
+ * @brief Send the frame behind a handle through a TX manager.
+ *
+ * Like can_tx_manager_send() without looking the tx_id up among the registered frames.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param timeout Timeout for the send operation
+ * @param callback Callback function to be called upon completion
+ * @param handle Frame handle returned by can_tx_manager_register()
+ * @param user_data Opaque pointer passed to the callback
+ * @return int 0 on success, -ENOENT if the frame was unregistered since (handles of a reused
+ *         slot are refused), -ENETUNREACH while the bus is off
+ */
+static inline int can_tx_manager_send_handle(const struct device *mgr, k_timeout_t timeout, can_tx_callback_t callback, int handle, void *user_data)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->send_handle == NULL) {
+        return -ENOSYS;
+    }
+    return api->send_handle(mgr, timeout, callback, handle, user_data);
+}
+
+/**
+ * @brief Write part of the payload of the frame behind a handle.
+ *
+ * Like can_tx_manager_write() without looking the tx_id up among the registered frames.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param handle Frame handle returned by can_tx_manager_register()
+ * @param offset First payload byte to write
+ * @param payload Bytes to write
+ * @param len Number of bytes
+ * @return int 0 on success, -ENOENT if the frame was unregistered since, -EINVAL if the
+ *         bytes do not fit the frame's DLC
+ */
+static inline int can_tx_manager_write_handle(const struct device *mgr, int handle, uint8_t offset, const uint8_t *payload, uint8_t len)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->write_handle == NULL) {
+        return -ENOSYS;
+    }
+    return api->write_handle(mgr, handle, offset, payload, len);
+}
+
+/**
+ * @brief Read the planned and measured per-tick load of the periodic schedule.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param stats Output statistics; sent_peak restarts after each read
+ * @return int 0 on success, negative error code on failure
+ */
+static inline int can_tx_manager_get_schedule(const struct device *mgr, struct can_tx_schedule_stats *stats)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->get_schedule == NULL) {
+        return -ENOSYS;
+    }
+    return api->get_schedule(mgr, stats);
+}
+
+/**
+ * @brief Send a periodic frame only when its payload changed or it got too old.
+ *
+ * On each due tick the frame is compared with the one last sent; an identical frame stays
+ * off the bus until max_age_ms have passed since that send, so receiver watchdogs still
+ * see it. Skipped sends are counted in can_tx_schedule_stats::unchanged. Frames sent with
+ * can_tx_manager_send() are not affected. Requires CONFIG_CAN_TX_MANAGER_ON_CHANGE.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame
+ * @param max_age_ms Longest gap between two sends of an unchanged frame; 0 sends every
+ *                   period again
+ * @return int 0 on success, -ENOENT if tx_id is not registered
+ */
+static inline int can_tx_manager_set_on_change(const struct device *mgr, uint16_t tx_id, uint32_t max_age_ms)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->set_on_change == NULL) {
+        return -ENOSYS;
+    }
+    return api->set_on_change(mgr, tx_id, max_age_ms);
+}
+
+/**
+ * @brief Change the transmit rate of a registered frame.
+ *
+ * The frame is rescheduled with a fresh phase; the periodic thread switches interval and
+ * phase together on its next tick. Senders sharing the tx_id share the new rate.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame
+ * @param frequency New rate in Hz (0 means event-driven), same limits as at registration
+ * @return int 0 on success, -ENOENT if tx_id is not registered, -EINVAL if the rate is too high
+ */
+static inline int can_tx_manager_set_frequency(const struct device *mgr, uint16_t tx_id, uint16_t frequency)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->set_frequency == NULL) {
+        return -ENOSYS;
+    }
+    return api->set_frequency(mgr, tx_id, frequency);
+}
+
+/**
+ * @brief Let the bus-load governor slow a periodic frame down.
+ *
+ * While the load measured by the RX manager of the bus stays above
+ * CONFIG_CAN_TX_MANAGER_GOVERNOR_HIGH_PERCENT, the governor halves the rate of every
+ * low-priority frame once per period, down to its min_frequency; below
+ * CONFIG_CAN_TX_MANAGER_GOVERNOR_LOW_PERCENT it restores them step by step. Untagged frames,
+ * e.g. motor control, always keep their rate. Requires CONFIG_CAN_TX_MANAGER_GOVERNOR.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame
+ * @param min_frequency Lowest rate in Hz the frame may be slowed to; 0 removes the tag
+ * @return int 0 on success, -ENOENT if tx_id is not registered
+ */
+static inline int can_tx_manager_set_low_priority(const struct device *mgr, uint16_t tx_id, uint16_t min_frequency)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->set_low_priority == NULL) {
+        return -ENOSYS;
+    }
+    return api->set_low_priority(mgr, tx_id, min_frequency);
+}
+
+/**
+ * @brief Send a frame right after the feedback of its motors instead of on a free-running period.
+ *
+ * The RX manager of the bus reports each feedback ID from its reception interrupt. Once all
+ * @p rx_ids have arrived, the frame is queued @p offset_us later (at once for 0) to the sync
+ * work queue (CONFIG_CAN_TX_MANAGER_SYNC_THREAD_PRIORITY), which sends it, so each cycle is
+ * sense, compute, actuate in one window: write the new payload within the offset. The offset
+ * is rounded to kernel ticks. When feedback is missing the
+ * frame is still sent @p timeout_us after the previous send. The frame leaves the periodic
+ * schedule while synchronized. Requires CONFIG_CAN_TX_MANAGER_SYNC.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param tx_id CAN identifier of a registered frame; its senders must not have fill callbacks
+ * @param rx_ids Feedback IDs of one cycle, e.g. 0x201..0x204 for a 0x200 frame
+ * @param rx_num Number of feedback IDs, at most CONFIG_CAN_TX_MANAGER_SYNC_MAX_IDS; 0 puts the
+ *               frame back on its periodic schedule
+ * @param offset_us Delay from the last feedback of a cycle to the frame
+ * @param timeout_us Longest gap between two sends without complete feedback, 0 for none
+ * @return int 0 on success, -ENOENT if tx_id is not registered, -ENOTSUP if the frame has
+ *         fill callbacks, -ENODEV without an RX manager on the bus
+ */
+static inline int can_tx_manager_set_sync(const struct device *mgr, uint16_t tx_id, const uint32_t *rx_ids, uint8_t rx_num, uint32_t offset_us, uint32_t timeout_us)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->set_sync == NULL) {
+        return -ENOSYS;
+    }
+    return api->set_sync(mgr, tx_id, rx_ids, rx_num, offset_us, timeout_us);
+}
+
+/**
+ * @brief Borrow a TX slot to build an event frame in place.
+ *
+ * The frame comes with the ID, DLC and flags of the registered frame; write the payload into
+ * it (all dlc bytes, the slot holds whatever was sent last) and pass it to
+ * can_tx_manager_commit(), or can_tx_manager_release() to drop it. Unlike
+ * can_tx_manager_send() this takes no lock, runs no fill callback and copies nothing.
+ * Never blocks; slots come from a pool of CONFIG_CAN_TX_MANAGER_TX_SLOTS per manager.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param handle Frame handle returned by can_tx_manager_register()
+ * @param frame Output: frame to fill
+ * @return int 0 on success, -ENOENT for a stale handle, -ENOBUFS if all slots are in flight
+ */
+static inline int can_tx_manager_reserve(const struct device *mgr, int handle, struct can_frame **frame)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->reserve == NULL) {
+        return -ENOSYS;
+    }
+    return api->reserve(mgr, handle, frame);
+}
+
+/**
+ * @brief Send a frame obtained from can_tx_manager_reserve().
+ *
+ * The slot goes back to the pool when the controller reports the transmission done, right
+ * before @p callback runs, or immediately if queuing fails. The frame must not be touched
+ * after this call.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param frame Frame from can_tx_manager_reserve()
+ * @param timeout Timeout for queuing the frame
+ * @param callback Callback function to be called upon completion, may be NULL
+ * @param user_data Opaque pointer passed to the callback
+ * @return int 0 on success, -ENETUNREACH while the bus is off, -EINVAL if the frame is not a
+ *         reserved slot of @p mgr, other can_send() errors
+ */
+static inline int can_tx_manager_commit(const struct device *mgr, struct can_frame *frame, k_timeout_t timeout, can_tx_callback_t callback, void *user_data)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->commit == NULL) {
+        return -ENOSYS;
+    }
+    return api->commit(mgr, frame, timeout, callback, user_data);
+}
+
+/**
+ * @brief Return a reserved frame to the pool without sending it.
+ *
+ * @param mgr Pointer to the CAN TX manager device
+ * @param frame Frame from can_tx_manager_reserve()
+ * @return int 0 on success, -EINVAL if the frame is not a reserved slot of @p mgr
+ */
+static inline int can_tx_manager_release(const struct device *mgr, struct can_frame *frame)
+{
+    const struct can_tx_manager_api *api = (const struct can_tx_manager_api *)mgr->api;
+    if(api->release == NULL) {
+        return -ENOSYS;
+    }
+    return api->release(mgr, frame);
+}
 
 
 #ifdef __cplusplus
@@ -14,6 +14,7 @@ extern "C"
     {
         uint64_t heartbeat_tick; // 心跳时间戳
         uint64_t probe_tick;     // 心跳探测时间戳
+        uint32_t rx_cycles;      // 最近一帧到达时的 k_cycle_get_32() 计数
         bool is_alive;           // 心跳状态
     } smotor_heartbeat_status_t;
 
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 RobotPilots-SZU
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CAN RX manager 分发开销基准：
+ * fdcan1 切到内部回环模式，自发自收，分别注册 2/16/64 个监听器，
+ * 统计 RX 线程每帧消耗的 CPU 周期；同时在本地跑一遍旧版的线性匹配循环作为对照。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include <string.h>
+
+#include <drivers/can_rx_manager.h>
+
+LOG_MODULE_REGISTER(can_rx_bench, LOG_LEVEL_INF);
+
+#define BENCH_FRAMES   CONFIG_CAN_RX_BENCH_FRAMES
+#define BENCH_RX_ID    0x201
+#define BENCH_DUMMY_ID 0x300
+
+static const struct device *const can_dev = DEVICE_DT_GET(DT_NODELABEL(fdcan1));
+static const struct device *const mgr = DEVICE_DT_GET(DT_NODELABEL(can_rx_mgr1));
+
+static const int listener_rounds[] = {2, 16, 64};
+
+static atomic_t rx_count;
+static int listener_ids[CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];
+static k_tid_t rx_thread;
+
+static void bench_rx_handler(const struct can_frame *frame, void *user_data)
+{
+	ARG_UNUSED(frame);
+	ARG_UNUSED(user_data);
+	(void)atomic_inc(&rx_count);
+}
+
+static void bench_dummy_handler(const struct can_frame *frame, void *user_data)
+{
+	ARG_UNUSED(frame);
+	ARG_UNUSED(user_data);
+}
+
+static void find_rx_thread(const struct k_thread *thread, void *user_data)
+{
+	ARG_UNUSED(user_data);
+	const char *name = k_thread_name_get((k_tid_t)thread);
+	if ((name != NULL) && (strcmp(name, "can_rx_mgr") == 0)) {
+		rx_thread = (k_tid_t)thread;
+	}
+}
+
+/* 旧版分发：遍历全部槽位并逐个软件匹配，用作“优化前”的参考 */
+struct ref_listener {
+	bool used;
+	struct can_filter filter;
+};
+
+static struct ref_listener ref_listeners[CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];
+
+static bool ref_match(const struct can_filter *filter, const struct can_frame *frame)
+{
+	if (((frame->flags & CAN_FRAME_IDE) != 0U) != ((filter->flags & CAN_FILTER_IDE) != 0U)) {
+		return false;
+	}
+	uint32_t id_mask = ((frame->flags & CAN_FRAME_IDE) != 0U) ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK;
+	return ((frame->id & id_mask & filter->mask) == (filter->id & id_mask & filter->mask));
+}
+
+static uint32_t ref_linear_cycles(int listeners, const struct can_frame *frame)
+{
+	volatile uint32_t hits = 0;
+
+	memset(ref_listeners, 0, sizeof(ref_listeners));
+	for (int i = 0; i < listeners; i++) {
+		ref_listeners[i].used = true;
+		ref_listeners[i].filter.id = (i == listeners - 1) ? BENCH_RX_ID : (BENCH_DUMMY_ID + i);
+		ref_listeners[i].filter.mask = CAN_STD_ID_MASK;
+	}
+
+	uint32_t start = k_cycle_get_32();
+	for (int n = 0; n < BENCH_FRAMES; n++) {
+		for (int i = 0; i < CONFIG_CAN_RX_MANAGER_MAX_LISTENERS; i++) {
+			if (!ref_listeners[i].used) {
+				continue;
+			}
+			if (!ref_match(&ref_listeners[i].filter, frame)) {
+				continue;
+			}
+			hits++;
+		}
+	}
+	return (k_cycle_get_32() - start) / BENCH_FRAMES;
+}
+
+static int run_round(int listeners)
+{
+	struct can_frame frame = {
+		.id = BENCH_RX_ID,
+		.dlc = 8,
+		.flags = 0,
+	};
+	struct can_filter filter = {.mask = CAN_STD_ID_MASK, .flags = 0};
+	int ret;
+
+	/* 目标监听器放在最后注册，线性遍历时处于最坏位置 */
+	for (int i = 0; i < listeners; i++) {
+		bool target = (i == listeners - 1);
+		filter.id = target ? BENCH_RX_ID : (BENCH_DUMMY_ID + i);
+		ret = can_rx_manager_register(mgr, &filter,
+					      target ? bench_rx_handler : bench_dummy_handler, NULL);
+		if (ret < 0) {
+			LOG_ERR("register listener %d failed: %d", i, ret);
+			return ret;
+		}
+		listener_ids[i] = ret;
+	}
+
+	k_thread_runtime_stats_t before;
+	k_thread_runtime_stats_t after;
+
+	atomic_set(&rx_count, 0);
+	k_thread_runtime_stats_get(rx_thread, &before);
+	for (int n = 0; n < BENCH_FRAMES; n++) {
+		ret = can_send(can_dev, &frame, K_FOREVER, NULL, NULL);
+		if (ret != 0) {
+			LOG_ERR("can_send failed: %d", ret);
+			break;
+		}
+	}
+	/* 等待 RX 线程处理完队列 */
+	for (int wait = 0; (atomic_get(&rx_count) < BENCH_FRAMES) && (wait < 1000); wait++) {
+		k_sleep(K_MSEC(1));
+	}
+	k_thread_runtime_stats_get(rx_thread, &after);
+
+	uint32_t received = (uint32_t)atomic_get(&rx_count);
+	uint64_t cycles = after.execution_cycles - before.execution_cycles;
+
+	LOG_INF("listeners=%2d received=%u/%u mgr=%u cyc/frame linear_ref=%u cyc/frame", listeners,
+		received, BENCH_FRAMES, (received > 0U) ? (uint32_t)(cycles / received) : 0U,
+		ref_linear_cycles(listeners, &frame));
+
+	for (int i = 0; i < listeners; i++) {
+		(void)can_rx_manager_unregister(mgr, listener_ids[i]);
+	}
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	if (!device_is_ready(can_dev) || !device_is_ready(mgr)) {
+		LOG_ERR("fdcan1 or can_rx_mgr1 not ready");
+		return -ENODEV;
+	}
+
+	k_thread_foreach(find_rx_thread, NULL);
+	if (rx_thread == NULL) {
+		LOG_ERR("can_rx_mgr thread not found (CONFIG_THREAD_NAME?)");
+		return -ENOENT;
+	}
+
+	/* 管理器 init 已启动 CAN，这里切到内部回环，不需要外部总线 */
+	(void)can_stop(can_dev);
+	ret = can_set_mode(can_dev, CAN_MODE_LOOPBACK);
+	if (ret != 0) {
+		LOG_ERR("failed to set loopback mode: %d", ret);
+		return ret;
+	}
+	ret = can_start(can_dev);
+	if ((ret < 0) && (ret != -EALREADY)) {
+		LOG_ERR("failed to start fdcan1: %d", ret);
+		return ret;
+	}
+
+	for (size_t r = 0; r < ARRAY_SIZE(listener_rounds); r++) {
+		int listeners = MIN(listener_rounds[r], CONFIG_CAN_RX_MANAGER_MAX_LISTENERS);
+		ret = run_round(listeners);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	LOG_INF("bench done");
+	return 0;
+}
@@ -22,8 +22,8 @@ static const struct device *can2_dev = NULL;
 static const struct device *can_mgr_dev = NULL;
 
 /* 发送器注册ID*/
-static int sender_event_id = -1;   /* 事件触发设备 */
-static int sender_periodic_id = -1; /* 定频发送设备 */
+static int sender_event_id = -1;   /* 事件触发设备的帧句柄 */
+static int sender_periodic_id = -1; /* 定频发送设备的帧句柄 */
 
 /* 接收计数器 */
 static volatile uint32_t rx_count = 0;
@@ -182,7 +182,7 @@ int main(void)
         LOG_ERR("Failed to register event-triggered sender: %d", sender_event_id);
         return sender_event_id;
     }
-    LOG_INF("Event-triggered sender registered, ID: %d", sender_event_id);
+    LOG_INF("Event-triggered sender registered, handle: %d", sender_event_id);
 
     // 挂载设备到 TX manager，这个设备为定周期发送
     static uint32_t periodic_counter = 0;
@@ -201,16 +201,24 @@ int main(void)
         LOG_ERR("Failed to register periodic sender: %d", sender_periodic_id);
         return sender_periodic_id;
     }
-    LOG_INF("Periodic sender registered, ID: %d (10Hz)", sender_periodic_id);
+    LOG_INF("Periodic sender registered, handle: %d (10Hz)", sender_periodic_id);
+
+    /* 查看定频帧的相位错开结果：单个 tick 内最多要发的帧数和总线占用 */
+    struct can_tx_schedule_stats sched;
+    if (can_tx_manager_get_schedule(can_mgr_dev, &sched) == 0) {
+        LOG_INF("Schedule: %u periodic frames, peak %u frames / %u bits per %u us tick (%u.%u%% of the bus)",
+                sched.periodic, sched.peak_frames, sched.peak_bits, sched.tick_us,
+                sched.peak_permille / 10U, sched.peak_permille % 10U);
+    }
 
-    // 手动发送三条报文
+    // 手动发送三条报文，用注册返回的句柄直接定位帧
     for (int i = 0; i < 3; i++) {
         event_counter = 100 + i;
-        int ret = can_tx_manager_send(
+        int ret = can_tx_manager_send_handle(
             can_mgr_dev,
             K_MSEC(100),        /* timeout */
             send_callback,              /* callback */
-            CAN_TX_ID_TEST1,     /* tx_id */
+            sender_event_id,     /* frame handle */
             NULL                        /* user_data for callback */
         );
 
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2025 RobotPilots-SZU
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CAN RX manager 饱和基准（native_sim）：
+ * 三个 zephyr,can-loopback 控制器模拟 1/2/3 条 1 Mbit/s 总线，发生器线程按满载节奏
+ * 周期性地向每条总线成批注入标准帧，每条总线分别挂 8/16/64 个监听器，统计：
+ * 分发帧率、RX 线程每帧周期、环形缓冲高水位和丢帧率。
+ * native_sim 上代码执行不消耗仿真时间，周期数只适合做相对比较，绝对值请在硬件上测。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include <string.h>
+
+#include <drivers/can_rx_manager.h>
+
+LOG_MODULE_REGISTER(can_rx_saturation, LOG_LEVEL_INF);
+
+#define SAT_BASE_ID   0x100
+#define SAT_BUS_KBPS  1000
+#define SAT_MAX_BUSES 3
+
+static const struct device *const can_devs[SAT_MAX_BUSES] = {
+	DEVICE_DT_GET(DT_NODELABEL(can_lb0)),
+	DEVICE_DT_GET(DT_NODELABEL(can_lb1)),
+	DEVICE_DT_GET(DT_NODELABEL(can_lb2)),
+};
+static const struct device *const mgrs[SAT_MAX_BUSES] = {
+	DEVICE_DT_GET(DT_NODELABEL(can_rx_mgr0)),
+	DEVICE_DT_GET(DT_NODELABEL(can_rx_mgr1)),
+	DEVICE_DT_GET(DT_NODELABEL(can_rx_mgr2)),
+};
+
+static const int bus_rounds[] = {1, 2, 3};
+static const int listener_rounds[] = {8, 16, 64};
+
+static atomic_t rx_count;
+static atomic_t gen_overrun;		/* 回环控制器发送队列满，帧未能注入 */
+static atomic_t gen_sent;
+static int listener_ids[SAT_MAX_BUSES][CONFIG_CAN_RX_MANAGER_MAX_LISTENERS];
+static k_tid_t rx_thread;
+
+/* 发生器状态，由 main 在每轮开始前设置 */
+static volatile int gen_buses;
+static volatile int gen_listeners;
+static volatile bool gen_running;
+static K_SEM_DEFINE(gen_sem, 0, 1);
+
+static void sat_rx_handler(const struct can_frame *frame, void *user_data)
+{
+	ARG_UNUSED(frame);
+	ARG_UNUSED(user_data);
+	(void)atomic_inc(&rx_count);
+}
+
+static void sat_tx_done(const struct device *dev, int error, void *user_data)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(error);
+	ARG_UNUSED(user_data);
+}
+
+static void sat_gen_tick(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+	k_sem_give(&gen_sem);
+}
+
+static K_TIMER_DEFINE(gen_timer, sat_gen_tick, NULL);
+
+/* 每个周期按 1 Mbit/s 满载补发这段时间里总线能承载的帧数 */
+static void sat_gen_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	uint32_t budget[SAT_MAX_BUSES] = {0};
+	uint32_t seq[SAT_MAX_BUSES] = {0};
+	struct can_frame frame = {
+		.dlc = 8,
+		.flags = 0,
+		.data = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88},
+	};
+
+	while (true) {
+		k_sem_take(&gen_sem, K_FOREVER);
+		if (!gen_running) {
+			memset(budget, 0, sizeof(budget));
+			continue;
+		}
+		for (int b = 0; b < gen_buses; b++) {
+			budget[b] += SAT_BUS_KBPS * CONFIG_CAN_RX_SAT_PERIOD_MS;
+			while (budget[b] >= CONFIG_CAN_RX_SAT_FRAME_BITS) {
+				budget[b] -= CONFIG_CAN_RX_SAT_FRAME_BITS;
+				/* 轮流命中每个监听器 */
+				frame.id = SAT_BASE_ID + (seq[b]++ % (uint32_t)gen_listeners);
+				if (can_send(can_devs[b], &frame, K_NO_WAIT, sat_tx_done, NULL) != 0) {
+					(void)atomic_inc(&gen_overrun);
+				} else {
+					(void)atomic_inc(&gen_sent);
+				}
+			}
+		}
+	}
+}
+
+K_THREAD_DEFINE(sat_gen, 1024, sat_gen_thread, NULL, NULL, NULL, K_PRIO_COOP(2), 0, 0);
+
+static void find_rx_thread(const struct k_thread *thread, void *user_data)
+{
+	ARG_UNUSED(user_data);
+	const char *name = k_thread_name_get((k_tid_t)thread);
+	if ((name != NULL) && (strcmp(name, "can_rx_mgr") == 0)) {
+		rx_thread = (k_tid_t)thread;
+	}
+}
+
+static int run_round(int buses, int listeners)
+{
+	struct can_filter filter = {.mask = CAN_STD_ID_MASK, .flags = 0};
+	struct can_rx_ring_stats before[SAT_MAX_BUSES];
+	struct can_rx_ring_stats after[SAT_MAX_BUSES];
+	int ret;
+
+	for (int b = 0; b < buses; b++) {
+		for (int i = 0; i < listeners; i++) {
+			filter.id = SAT_BASE_ID + i;
+			ret = can_rx_manager_register(mgrs[b], &filter, sat_rx_handler, NULL);
+			if (ret < 0) {
+				LOG_ERR("bus %d: register listener %d failed: %d", b, i, ret);
+				return ret;
+			}
+			listener_ids[b][i] = ret;
+		}
+		/* 读一次以清零高水位 */
+		(void)can_rx_manager_get_ring_stats(mgrs[b], &before[b]);
+	}
+
+	k_thread_runtime_stats_t rt_before;
+	k_thread_runtime_stats_t rt_after;
+
+	atomic_set(&rx_count, 0);
+	atomic_set(&gen_overrun, 0);
+	atomic_set(&gen_sent, 0);
+	gen_buses = buses;
+	gen_listeners = listeners;
+	k_thread_runtime_stats_get(rx_thread, &rt_before);
+
+	gen_running = true;
+	k_timer_start(&gen_timer, K_MSEC(CONFIG_CAN_RX_SAT_PERIOD_MS), K_MSEC(CONFIG_CAN_RX_SAT_PERIOD_MS));
+	k_sleep(K_MSEC(CONFIG_CAN_RX_SAT_DURATION_MS));
+	k_timer_stop(&gen_timer);
+	gen_running = false;
+
+	/* 等待回环控制器和 RX 线程处理完剩余帧 */
+	for (int wait = 0; wait < 100; wait++) {
+		atomic_val_t seen = atomic_get(&rx_count);
+		k_sleep(K_MSEC(5));
+		if (atomic_get(&rx_count) == seen) {
+			break;
+		}
+	}
+	k_thread_runtime_stats_get(rx_thread, &rt_after);
+
+	uint32_t queued = 0U;
+	uint32_t dropped = 0U;
+	uint32_t hwm_pct = 0U;
+	for (int b = 0; b < buses; b++) {
+		(void)can_rx_manager_get_ring_stats(mgrs[b], &after[b]);
+		queued += after[b].queued - before[b].queued;
+		dropped += after[b].dropped - before[b].dropped;
+		hwm_pct = MAX(hwm_pct, after[b].high_water * 100U / after[b].size);
+	}
+
+	uint32_t received = (uint32_t)atomic_get(&rx_count);
+	uint64_t cycles = rt_after.execution_cycles - rt_before.execution_cycles;
+	uint32_t offered = queued + dropped;
+	uint32_t drop_permille = (offered > 0U) ? (uint32_t)((uint64_t)dropped * 1000U / offered) : 0U;
+	int load = (int)can_rx_manager_calculate_load(mgrs[0], 0, 0);
+
+	LOG_INF("buses=%d listeners=%2d sent=%d fps=%u cyc/frame=%u hwm=%u%% drop=%u.%u%% gen_overrun=%d load=%d%%",
+		buses, listeners, (int)atomic_get(&gen_sent),
+		(uint32_t)((uint64_t)received * 1000U / CONFIG_CAN_RX_SAT_DURATION_MS),
+		(received > 0U) ? (uint32_t)(cycles / received) : 0U, hwm_pct, drop_permille / 10U,
+		drop_permille % 10U, (int)atomic_get(&gen_overrun), load);
+
+	for (int b = 0; b < buses; b++) {
+		for (int i = 0; i < listeners; i++) {
+			(void)can_rx_manager_unregister(mgrs[b], listener_ids[b][i]);
+		}
+	}
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	for (int b = 0; b < SAT_MAX_BUSES; b++) {
+		if (!device_is_ready(can_devs[b]) || !device_is_ready(mgrs[b])) {
+			LOG_ERR("bus %d: controller or manager not ready", b);
+			return -ENODEV;
+		}
+		/* 管理器 init 已启动控制器，这里切到回环模式 */
+		(void)can_stop(can_devs[b]);
+		ret = can_set_mode(can_devs[b], CAN_MODE_LOOPBACK);
+		if (ret != 0) {
+			LOG_ERR("bus %d: failed to set loopback mode: %d", b, ret);
+			return ret;
+		}
+		ret = can_start(can_devs[b]);
+		if ((ret < 0) && (ret != -EALREADY)) {
+			LOG_ERR("bus %d: failed to start: %d", b, ret);
+			return ret;
+		}
+	}
+
+	k_thread_foreach(find_rx_thread, NULL);
+	if (rx_thread == NULL) {
+		LOG_ERR("can_rx_mgr thread not found (CONFIG_THREAD_NAME?)");
+		return -ENOENT;
+	}
+
+	for (size_t r = 0; r < ARRAY_SIZE(bus_rounds); r++) {
+		for (size_t l = 0; l < ARRAY_SIZE(listener_rounds); l++) {
+			int listeners = MIN(listener_rounds[l], CONFIG_CAN_RX_MANAGER_MAX_LISTENERS);
+			ret = run_round(bus_rounds[r], listeners);
+			if (ret != 0) {
+				return ret;
+			}
+		}
+	}
+
+	LOG_INF("saturation done");
+	return 0;
+}